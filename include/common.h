@@ -8,9 +8,13 @@
 /* ============================================
  * GRID CONFIGURATION
  * ============================================ */
-#define GRID_WIDTH 20
-#define GRID_HEIGHT 20
-#define GRID_SIZE (GRID_WIDTH * GRID_HEIGHT)
+/* Board size is chosen at runtime (--width/--height); these are the defaults */
+#define DEFAULT_GRID_WIDTH 20
+#define DEFAULT_GRID_HEIGHT 20
+
+/* Accepted board dimensions (the initial snake needs room to spawn) */
+#define MIN_GRID_DIMENSION 5
+#define MAX_GRID_DIMENSION 1024
 
 /* ============================================
  * GAME CONFIGURATION
@@ -18,10 +22,10 @@
 #define INITIAL_SNAKE_LENGTH 3
 #define TARGET_FPS 10
 #define FRAME_DELAY_MS (1000 / TARGET_FPS)
-#define MAX_AI_COMPUTE_MS 10
+#define MAX_AI_COMPUTE_MS 10       /* Default interactive decision budget (--budget) */
 
-/* Queue capacity for BFS (worst case: entire grid + 1) */
-#define QUEUE_CAPACITY (GRID_SIZE + 1)
+/* Headless runs stop a game after this many board sizes of moves without food */
+#define SIMULATION_STALL_FACTOR 4
 
 /* ============================================
  * CELL TYPES
@@ -81,6 +85,16 @@ typedef enum {
     MODE_AI_DEMO
 } GameMode;
 
+/* ============================================
+ * PATH SEARCH ALGORITHMS
+ * ============================================ */
+typedef enum {
+    PATH_ALGORITHM_BFS,         /* Breadth-first search */
+    PATH_ALGORITHM_ASTAR,       /* A* with Manhattan distance heuristic */
+    PATH_ALGORITHM_TIMED_BFS,   /* BFS through body cells vacated before the head arrives */
+    PATH_ALGORITHM_COUNT
+} PathAlgorithm;
+
 /* ============================================
  * GAME STATUS
  * ============================================ */
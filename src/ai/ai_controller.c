@@ -6,14 +6,103 @@
 #include "../utils/memory_tracker.h"
 #include <stdlib.h>
 #include <limits.h>
+#include <assert.h>
 
-AIDecision* ai_make_decision(GameState* state) {
-    if (!state || !state->snake) {
+AIController* ai_controller_create(int grid_width, int grid_height, const AIStrategyOps* strategy) {
+    if (grid_width <= 0 || grid_height <= 0 || !strategy || !strategy->decide) {
         return NULL;
     }
 
+    if (strategy->supports_board && !strategy->supports_board(grid_width, grid_height)) {
+        return NULL;
+    }
+
+    AIController* controller = (AIController*)memory_tracked_malloc(sizeof(AIController));
+    if (!controller) {
+        return NULL;
+    }
+
+    controller->strategy = strategy;
+    controller->strategy_state = NULL;
+    controller->path_algorithm = PATH_ALGORITHM_ASTAR;
+    controller->time_budget_us = 0;
+    controller->chokepoint_generation = 0;
+    controller->chokepoint_moves = 0;
+    controller->chokepoints_ready = false;
+    controller->workspace = search_workspace_create((size_t)grid_width * (size_t)grid_height);
+    controller->chokepoints = chokepoint_map_create(grid_width, grid_height);
+    if (!controller->workspace || !controller->chokepoints) {
+        ai_controller_destroy(controller);
+        return NULL;
+    }
+
+    if (strategy->init && !strategy->init(controller, grid_width, grid_height)) {
+        ai_controller_destroy(controller);
+        return NULL;
+    }
+
+    return controller;
+}
+
+void ai_controller_destroy(AIController* controller) {
+    if (!controller) {
+        return;
+    }
+
+    if (controller->strategy->destroy) {
+        controller->strategy->destroy(controller);
+    }
+
+    search_workspace_destroy(controller->workspace);
+    chokepoint_map_destroy(controller->chokepoints);
+    memory_tracked_free(controller);
+}
+
+void ai_controller_on_move(AIController* controller, const GameState* state, Direction move) {
+    if (!controller || !state || !controller->strategy->on_move) {
+        return;
+    }
+
+    controller->strategy->on_move(controller, state, move);
+}
+
+/* Safety check of a move, run on first use this tick */
+static SafetyResult* ai_move_safety(AIController* controller, GameState* state,
+                                    MoveEvaluations* evals, Direction dir) {
+    if (!evals->safety[dir]) {
+        evals->safety[dir] = safety_check_move(&state->grid, controller->workspace,
+                                               state->snake, dir, state->grid.food_pos);
+    }
+    return evals->safety[dir];
+}
+
+/* Space after every move: one labeling pass fills all four directions, once per tick */
+static void ai_label_spaces(AIController* controller, GameState* state, MoveEvaluations* evals) {
+    if (!evals->spaces_ready) {
+        space_analyze_moves(&state->grid, controller->workspace, state->snake,
+                            state->grid.food_pos, evals->space);
+        evals->spaces_ready = true;
+    }
+}
+
+/* Space after a move, labeled on first use */
+static SpaceAnalysis* ai_move_space(AIController* controller, GameState* state,
+                                    MoveEvaluations* evals, Direction dir) {
+    ai_label_spaces(controller, state, evals);
+    return evals->space[dir];
+}
+
+AIDecision* ai_make_decision(AIController* controller, GameState* state) {
+    if (!controller || !state || !state->snake) {
+        return NULL;
+    }
+
+    /* Results of the previous decision die here; reuse their storage */
+    MemoryArena* results = &controller->workspace->results;
+    memory_arena_reset(results);
+
     /* Allocate decision */
-    AIDecision* decision = (AIDecision*)memory_tracked_malloc(sizeof(AIDecision));
+    AIDecision* decision = (AIDecision*)memory_arena_alloc(results, sizeof(AIDecision));
     if (!decision) {
         return NULL;
     }
@@ -21,23 +110,87 @@ AIDecision* ai_make_decision(GameState* state) {
     decision->chosen_direction = DIR_NONE;
     decision->path_to_food = NULL;
     decision->safety_check = NULL;
+    decision->path_safety = NULL;
     decision->space_analysis = NULL;
     decision->total_compute_time_us = 0;
+    decision->hit_deadline = false;
     decision->used_fallback = false;
     decision->used_space_strategy = false;
+    decision->used_hamiltonian = false;
 
     /* Start timing */
     Timer total_timer;
     timer_start(&total_timer);
 
-    /* Sync grid with current snake position */
-    game_state_sync_grid(state);
+    /* Anytime mode: searches of this decision give up at the deadline */
+    SearchWorkspace* workspace = controller->workspace;
+    search_workspace_set_deadline(workspace, controller->time_budget_us > 0 ?
+                                  timer_now_us() + controller->time_budget_us : 0);
+
+    /* The grid is already in sync: game_state_update maintains it incrementally */
+
+    /* Searches of this tick, shared by the strategy and the display */
+    MoveEvaluations evals = {{NULL}, {NULL}, false, DIR_NONE};
+
+    decision->chosen_direction = controller->strategy->decide(controller, state, decision, &evals);
+
+    /* Safety check of the chosen direction (for display; usually already run) */
+    if (decision->chosen_direction != DIR_NONE && !decision->used_hamiltonian) {
+        decision->safety_check = ai_move_safety(controller, state, &evals,
+                                                decision->chosen_direction);
+    }
+
+    decision->hit_deadline = workspace->deadline_passed;
+    search_workspace_set_deadline(workspace, 0);
+
+    /* Stop timing */
+    timer_stop(&total_timer);
+    decision->total_compute_time_us = timer_elapsed_us(&total_timer);
+
+    /* Update state statistics */
+    state->total_ai_time_us += decision->total_compute_time_us;
+
+    return decision;
+}
+
+Direction ai_space_decide(AIController* controller, GameState* state,
+                          AIDecision* decision, MoveEvaluations* evals) {
+    if (!controller || !state || !state->snake || !decision || !evals) {
+        return DIR_NONE;
+    }
 
-    Position head_pos = state->snake->head->pos;
     Position food_pos = state->grid.food_pos;
 
-    /* Find path to food using BFS (for reference and tie-breaking) */
-    decision->path_to_food = pathfinding_bfs(&state->grid, head_pos, food_pos);
+    /*
+     * Every candidate is rated on space, so label it before any search can
+     * use up the budget: one sweep of the board, cut off only by a budget
+     * shorter than the sweep itself.
+     */
+    ai_label_spaces(controller, state, evals);
+
+    /* Find path to food (for reference and display) */
+    decision->path_to_food = pathfinding_find_path(controller->path_algorithm, &state->grid,
+                                                   controller->workspace, state->snake, food_pos);
+
+    /*
+     * Full-path safety: if the snake would be trapped after following
+     * the whole path and eating, its first step loses the food-distance
+     * preference below. (A one-move path is the food move itself, which
+     * the per-move safety check already simulates.) Past the deadline the
+     * simulation is skipped, and a check cut off at the deadline proves
+     * nothing and is ignored. Checking with 0 expansions reads the clock.
+     */
+    PathResult* path = decision->path_to_food;
+    if (path && path->found && path->length > 2 &&
+        !search_workspace_out_of_time(controller->workspace, 0)) {
+        decision->path_safety = safety_check_path(&state->grid, controller->workspace,
+                                                  state->snake, path);
+        if (decision->path_safety && !decision->path_safety->is_safe &&
+            !controller->workspace->deadline_passed) {
+            evals->trap_step = pathfinding_get_next_direction(path->positions[0],
+                                                              path->positions[1]);
+        }
+    }
 
     /*
      * Phase 5: Space-Maximization Strategy
@@ -49,64 +202,123 @@ AIDecision* ai_make_decision(GameState* state) {
      *
      * This enables near-perfect play by maintaining maneuvering room.
      */
-    decision->chosen_direction = ai_space_maximization_strategy(state, &decision->space_analysis);
+    decision->chosen_direction = ai_space_maximization_strategy(controller, state, evals,
+                                                                &decision->space_analysis);
     decision->used_space_strategy = true;
 
     /* If space strategy failed, use fallback */
     if (decision->chosen_direction == DIR_NONE) {
-        decision->chosen_direction = ai_fallback_strategy(state);
+        decision->chosen_direction = ai_fallback_strategy(controller, state, evals);
         decision->used_fallback = true;
         decision->used_space_strategy = false;
     }
 
-    /* Get safety check for the chosen direction (for display purposes) */
-    if (decision->chosen_direction != DIR_NONE) {
-        decision->safety_check = safety_check_move(&state->grid, state->snake,
-                                                   decision->chosen_direction, food_pos);
-    }
-
-    /* Stop timing */
-    timer_stop(&total_timer);
-    decision->total_compute_time_us = timer_elapsed_us(&total_timer);
+    return decision->chosen_direction;
+}
 
-    /* Update state statistics */
-    state->total_ai_time_us += decision->total_compute_time_us;
+/*
+ * Bring the chokepoint map up to the current tick. One tick after the last
+ * analysis only the head (now blocked) and the tail cell (now walkable)
+ * changed, so only their regions are re-analyzed (all of the free space
+ * while it is one region); otherwise the whole board is.
+ * The map only carries over within one game: a restart (game_state_reset)
+ * starts a new generation whose move counts repeat the old game's.
+ * Returns false if the deadline cut the analysis off; the map is then
+ * analyzed from scratch on the next call.
+ */
+static bool ai_update_chokepoints(AIController* controller, GameState* state) {
+    bool same_game = controller->chokepoints_ready &&
+                     state->generation == controller->chokepoint_generation;
+    bool complete = true;
+
+    if (same_game && state->moves_count == controller->chokepoint_moves + 1) {
+        Position changed[2] = {snake_head(state->snake), snake_tail(state->snake)};
+        complete = chokepoint_map_update(controller->chokepoints, &state->grid,
+                                         controller->workspace, changed, 2);
+    } else if (!same_game || state->moves_count != controller->chokepoint_moves) {
+        complete = chokepoint_map_analyze(controller->chokepoints, &state->grid,
+                                          controller->workspace);
+    }
 
-    return decision;
+    controller->chokepoint_generation = state->generation;
+    controller->chokepoint_moves = state->moves_count;
+    controller->chokepoints_ready = complete;
+    return complete;
 }
 
-void ai_decision_destroy(AIDecision* decision) {
-    if (!decision) {
-        return;
+#ifdef OUROBOROS_DEBUG_CHECKS
+/* Check a cell's chokepoint data against flood fills with the cell blocked */
+static void ai_verify_chokepoint(AIController* controller, Grid* grid, Position pos) {
+    size_t cell = grid_index(grid, pos);
+    CellType type = grid_get_cell(grid, pos);
+    grid_set_cell(grid, pos, CELL_SNAKE_BODY);
+
+    Position neighbors[4];
+    int neighbor_count = 0;
+    for (int d = DIR_UP; d <= DIR_RIGHT; d++) {
+        Position neighbor = position_move(pos, (Direction)d);
+        if (grid_is_walkable(grid, neighbor)) {
+            neighbors[neighbor_count++] = neighbor;
+        }
     }
 
-    if (decision->path_to_food) {
-        pathfinding_free_result(decision->path_to_food);
-    }
+    /* One fill per piece: neighbors reached by an earlier fill share its piece */
+    size_t largest = 0;
+    int pieces = 0;
+    bool counted[4] = {false, false, false, false};
+    for (int i = 0; i < neighbor_count; i++) {
+        if (counted[i]) {
+            continue;
+        }
 
-    /* Phase 4: Clean up safety check result */
-    if (decision->safety_check) {
-        safety_result_destroy(decision->safety_check);
-    }
+        SpaceAnalysis* space = space_analyze(grid, controller->workspace, neighbors[i]);
+        if (space && space->accessible_cells > largest) {
+            largest = space->accessible_cells;
+        }
+        pieces++;
 
-    /* Phase 5: Clean up space analysis result */
-    if (decision->space_analysis) {
-        space_analysis_destroy(decision->space_analysis);
+        for (int j = i + 1; j < neighbor_count; j++) {
+            counted[j] |= bitboard_test(&grid->visited, neighbors[j]);
+        }
     }
 
-    memory_tracked_free(decision);
+    grid_set_cell(grid, pos, type);
+
+    assert(chokepoint_space_beyond(controller->chokepoints, cell) == largest);
+    assert(chokepoint_is_articulation(controller->chokepoints, cell) == (pieces >= 2));
 }
+#endif
 
-Direction ai_space_maximization_strategy(GameState* state, SpaceAnalysis** space_result) {
-    if (!state || !state->snake || !space_result) {
+Direction ai_space_maximization_strategy(AIController* controller, GameState* state,
+                                         MoveEvaluations* evals, SpaceAnalysis** space_result) {
+    if (!controller || !state || !state->snake || !evals || !space_result) {
         return DIR_NONE;
     }
 
-    Position head_pos = state->snake->head->pos;
+    Position head_pos = snake_head(state->snake);
     Position food_pos = state->grid.food_pos;
 
-    /* Evaluate all four directions */
-    Direction dirs[4] = {DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT};
+    /*
+     * Evaluate all four directions, cheapest first: only the move onto the
+     * food needs a search (its escape path), so it goes last and a deadline
+     * never leaves the other moves unrated. It is the only move at food
+     * distance 0, so it never ties with another and the order does not
+     * change the choice.
+     */
+    Direction dirs[4];
+    int dir_count = 0;
+    Direction food_dir = DIR_NONE;
+    for (int d = DIR_UP; d <= DIR_RIGHT; d++) {
+        if (position_equals(position_move(head_pos, (Direction)d), food_pos)) {
+            food_dir = (Direction)d;
+        } else {
+            dirs[dir_count++] = (Direction)d;
+        }
+    }
+    if (food_dir != DIR_NONE) {
+        dirs[dir_count++] = food_dir;
+    }
+
     Direction best_dir = DIR_NONE;
     size_t best_space = 0;
     int best_distance_to_food = INT_MAX;
@@ -114,12 +326,12 @@ Direction ai_space_maximization_strategy(GameState* state, SpaceAnalysis** space
     /* Minimum required space: at least snake length to ensure maneuvering room */
     size_t min_required_space = state->snake->length;
 
-    for (int i = 0; i < 4; i++) {
+    for (int i = 0; i < dir_count; i++) {
         Direction dir = dirs[i];
         Position new_head = position_move(head_pos, dir);
 
         /* Skip invalid positions */
-        if (!grid_is_valid_position(new_head)) {
+        if (!grid_is_valid_position(&state->grid, new_head)) {
             continue;
         }
 
@@ -129,24 +341,44 @@ Direction ai_space_maximization_strategy(GameState* state, SpaceAnalysis** space
         }
 
         /* Check safety first (Phase 4) */
-        SafetyResult* safety = safety_check_move(&state->grid, state->snake, dir, food_pos);
-        bool is_safe = (safety && safety->is_safe);
-        safety_result_destroy(safety);
-
-        if (!is_safe) {
+        SafetyResult* safety = ai_move_safety(controller, state, evals, dir);
+        if (!safety || !safety->is_safe) {
             continue;  /* Skip unsafe moves */
         }
 
         /* Analyze accessible space after this move (Phase 5) */
-        SpaceAnalysis* space = space_analyze_move(&state->grid, state->snake, dir, food_pos);
-
+        SpaceAnalysis* space = ai_move_space(controller, state, evals, dir);
         if (!space || !space->is_valid) {
-            space_analysis_destroy(space);
             continue;
         }
 
+        /*
+         * Past a chokepoint only its largest side remains. The new head has
+         * at most three free neighbors, so that side holds at least a third
+         * of the rest of the region: only small regions need the analysis.
+         * Past the deadline, or cut off by it, the analysis proves nothing
+         * and the move is rated on space alone.
+         */
+        bool cuts_off_space = false;
+        if (space->accessible_cells >= min_required_space &&
+            space->accessible_cells - 1 < 3 * min_required_space &&
+            !search_workspace_out_of_time(controller->workspace, 0) &&
+            ai_update_chokepoints(controller, state)) {
+            size_t new_head_cell = grid_index(&state->grid, new_head);
+            cuts_off_space = chokepoint_is_articulation(controller->chokepoints, new_head_cell) &&
+                chokepoint_space_beyond(controller->chokepoints, new_head_cell) < min_required_space;
+
+#ifdef OUROBOROS_DEBUG_CHECKS
+            ai_verify_chokepoint(controller, &state->grid, new_head);
+#endif
+        }
+
         /* Calculate distance to food from new position (for tie-breaking) */
         int distance_to_food = abs(new_head.x - food_pos.x) + abs(new_head.y - food_pos.y);
+        if (dir == evals->trap_step) {
+            /* Heading down a food path that ends in a trap: no closer to food */
+            distance_to_food = INT_MAX - 1;
+        }
 
         /*
          * Selection criteria (in order of priority):
@@ -156,7 +388,7 @@ Direction ai_space_maximization_strategy(GameState* state, SpaceAnalysis** space
          */
         bool is_better = false;
 
-        if (space->accessible_cells >= min_required_space) {
+        if (space->accessible_cells >= min_required_space && !cuts_off_space) {
             if (best_dir == DIR_NONE) {
                 /* First valid move found */
                 is_better = true;
@@ -175,20 +407,15 @@ Direction ai_space_maximization_strategy(GameState* state, SpaceAnalysis** space
             best_distance_to_food = distance_to_food;
 
             /* Store space analysis for the best move */
-            if (*space_result) {
-                space_analysis_destroy(*space_result);
-            }
             *space_result = space;
-        } else {
-            space_analysis_destroy(space);
         }
     }
 
     return best_dir;
 }
 
-Direction ai_fallback_strategy(GameState* state) {
-    if (!state || !state->snake || !state->snake->head) {
+Direction ai_fallback_strategy(AIController* controller, GameState* state, MoveEvaluations* evals) {
+    if (!controller || !state || !state->snake || !evals) {
         return DIR_RIGHT;  /* Default direction */
     }
 
@@ -199,19 +426,19 @@ Direction ai_fallback_strategy(GameState* state) {
      * the one with maximum accessible space, ignoring food proximity.
      */
 
-    Position head_pos = state->snake->head->pos;
-    Position food_pos = state->grid.food_pos;
+    Position head_pos = snake_head(state->snake);
 
     Direction dirs[4] = {DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT};
     Direction best_dir = state->snake->current_direction;  /* Default: keep moving */
     size_t best_space = 0;
+    bool walkable_seen = false;
 
     for (int i = 0; i < 4; i++) {
         Direction dir = dirs[i];
         Position new_head = position_move(head_pos, dir);
 
         /* Skip invalid positions */
-        if (!grid_is_valid_position(new_head)) {
+        if (!grid_is_valid_position(&state->grid, new_head)) {
             continue;
         }
 
@@ -220,15 +447,20 @@ Direction ai_fallback_strategy(GameState* state) {
             continue;
         }
 
-        /* Analyze space (don't check safety - desperate situation) */
-        SpaceAnalysis* space = space_analyze_move(&state->grid, state->snake, dir, food_pos);
+        /* Should labeling be cut off at the deadline, an unrated open cell beats the default */
+        if (!walkable_seen) {
+            best_dir = dir;
+            walkable_seen = true;
+        }
+
+        /* Space of this move (don't check safety - desperate situation) */
+        SpaceAnalysis* space = ai_move_space(controller, state, evals, dir);
 
         if (space && space->is_valid) {
             if (space->accessible_cells > best_space) {
                 best_dir = dir;
                 best_space = space->accessible_cells;
             }
-            space_analysis_destroy(space);
         }
     }
 
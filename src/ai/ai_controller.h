@@ -6,45 +6,136 @@
 #include "pathfinding.h"
 #include "safety_checker.h"
 #include "space_analyzer.h"
+#include "search_workspace.h"
+#include "chokepoint_analyzer.h"
+#include "strategy.h"
+
+/**
+ * AI controller
+ * Long-lived AI state for one game (or one worker thread): owns the search
+ * scratch buffers so that decisions do not allocate per search, and the
+ * state of its decision strategy.
+ */
+typedef struct AIController {
+    SearchWorkspace* workspace;     /* Shared by pathfinding, safety and space analysis */
+    const AIStrategyOps* strategy;  /* Decision strategy (see strategy.h) */
+    void* strategy_state;           /* Owned by the strategy (init/destroy), NULL if unused */
+    PathAlgorithm path_algorithm;   /* Search for the path to food (default A*) */
+    uint64_t time_budget_us;        /* Anytime mode: per-decision search budget, 0 = unbounded */
+    ChokepointMap* chokepoints;     /* Articulation points of the free cells */
+    uint32_t chokepoint_generation; /* Game generation the chokepoint map was analyzed in */
+    uint32_t chokepoint_moves;      /* moves_count the chokepoint map was analyzed at */
+    bool chokepoints_ready;         /* The map holds an analysis of some earlier tick */
+} AIController;
+
+/**
+ * Per-tick move evaluations
+ * Every safety check and the space labeling run at most once per decision;
+ * the strategies and the display safety check all read them from here.
+ */
+typedef struct MoveEvaluations {
+    SafetyResult* safety[5];        /* Safety check per Direction (NULL until checked) */
+    SpaceAnalysis* space[5];        /* Space after each move per Direction */
+    bool spaces_ready;              /* space[] has been filled */
+    Direction trap_step;            /* First step of a food path that traps the snake, or DIR_NONE */
+} MoveEvaluations;
 
 /**
  * AI decision structure
  * Contains the AI's chosen direction and decision metadata
  */
-typedef struct {
+typedef struct AIDecision {
     Direction chosen_direction;
     PathResult* path_to_food;
     SafetyResult* safety_check;     /* Phase 4: Safety validation result */
+    SafetyResult* path_safety;      /* Full-path check of path_to_food (NULL if not run) */
     SpaceAnalysis* space_analysis;  /* Phase 5: Accessible space analysis */
     uint64_t total_compute_time_us;
+    bool hit_deadline;              /* Budget ran out: best move found before the deadline */
     bool used_fallback;             /* If greedy path failed, used space-maximization */
     bool used_space_strategy;       /* Phase 5: Used space-aware decision making */
+    bool used_hamiltonian;          /* Move came from the Hamiltonian cycle */
 } AIDecision;
 
+/**
+ * Create an AI controller for a board size
+ * Fails if the strategy does not support the board (supports_board) or its
+ * init fails.
+ * @param grid_width Board width in cells
+ * @param grid_height Board height in cells
+ * @param strategy Decision strategy (see ai_strategy_find)
+ * @return Pointer to new controller or NULL on failure
+ */
+AIController* ai_controller_create(int grid_width, int grid_height, const AIStrategyOps* strategy);
+
+/**
+ * Destroy AI controller, its workspace and its strategy state
+ * @param controller Controller to destroy
+ */
+void ai_controller_destroy(AIController* controller);
+
+/**
+ * Tell the controller's strategy that a move has been applied
+ * Call after game_state_update, once per move.
+ * @param controller AI controller
+ * @param state Game state after the move
+ * @param move Direction that was applied
+ */
+void ai_controller_on_move(AIController* controller, const GameState* state, Direction move);
+
 /**
  * Make an AI decision for the current game state
- * Phase 5: Uses space-maximization + safety validation for perfect play
+ * The controller's strategy chooses the move; this call owns the result
+ * arena, timing, the shared move evaluations and the display safety check.
  *
- * Decision algorithm:
- * 1. Find shortest path to food (BFS)
- * 2. For each valid direction:
+ * Decision algorithm of the default strategy (ai_space_decide):
+ * 1. Find shortest path to food (controller->path_algorithm)
+ * 2. Simulate following that whole path: if the snake would be trapped
+ *    after eating, its first step gets no food-distance preference
+ * 3. For each valid direction:
  *    - Check safety (escape route exists)
  *    - Analyze accessible space after move
- * 3. Choose move that maximizes accessible space (must be >= snake length)
- * 4. Use distance to food as tie-breaker
+ * 4. Choose move that maximizes accessible space (must be >= snake length,
+ *    also on the far side when the move enters a chokepoint)
+ * 5. Use distance to food as tie-breaker
  *
  * This prevents self-trapping by ensuring adequate maneuvering room.
+ * Each search runs at most once per decision (see MoveEvaluations).
  *
+ * Anytime mode (controller->time_budget_us > 0): every pass over the board
+ * (path searches, the full-path simulation, the space labeling and the
+ * chokepoint analysis) checks the deadline as it goes and gives up once the
+ * budget has passed. A cut-off path search finds no path, a cut-off
+ * full-path check is ignored, a move whose safety check was cut off counts
+ * as unsafe, a cut-off chokepoint analysis leaves the move rated on space
+ * alone, and a cut-off labeling leaves every move unrated (the fallback then
+ * takes any open cell). The space labeling runs first, so only a budget
+ * smaller than one sweep of the board cuts it off. Between stages the
+ * deadline is checked again and stages it has passed are skipped. The
+ * decision is the best one found in time, finishing within about one check
+ * interval of the deadline; decision->hit_deadline reports it.
+ *
+ * @param controller AI controller (sized for the state's board)
  * @param state Current game state
- * @return AIDecision (must be freed with ai_decision_destroy)
+ * @return AIDecision, allocated from the controller's result arena together
+ *         with its path, safety and space results; valid until the next
+ *         ai_make_decision call on the same controller (never freed by the caller)
  */
-AIDecision* ai_make_decision(GameState* state);
+AIDecision* ai_make_decision(AIController* controller, GameState* state);
 
 /**
- * Free AI decision and associated data
- * @param decision AIDecision to free
+ * Space pipeline: path to food, full-path check, space strategy, fallback
+ * The decide hook of the "space" strategy, also used by strategies that
+ * defer to it (e.g. the Hamiltonian strategy before the snake is on its cycle).
+ *
+ * @param controller AI controller
+ * @param state Current game state
+ * @param decision Decision to fill (path, path safety, space, flags)
+ * @param evals This tick's move evaluations (filled on demand)
+ * @return Direction to move
  */
-void ai_decision_destroy(AIDecision* decision);
+Direction ai_space_decide(AIController* controller, GameState* state,
+                          AIDecision* decision, MoveEvaluations* evals);
 
 /**
  * Fallback strategy: maximize accessible space
@@ -53,10 +144,12 @@ void ai_decision_destroy(AIDecision* decision);
  * Phase 5: Instead of just chasing tail, evaluate all safe moves
  * and choose the one that maximizes accessible space.
  *
+ * @param controller AI controller
  * @param state Current game state
+ * @param evals This tick's move evaluations (filled on demand)
  * @return Direction to move
  */
-Direction ai_fallback_strategy(GameState* state);
+Direction ai_fallback_strategy(AIController* controller, GameState* state, MoveEvaluations* evals);
 
 /**
  * Space-maximization strategy: choose move with most accessible cells
@@ -65,12 +158,20 @@ Direction ai_fallback_strategy(GameState* state);
  * Evaluates all four directions and chooses the one that:
  * 1. Is safe (passes safety validation)
  * 2. Maximizes accessible space (prefers open areas)
- * 3. Minimizes distance to food (tie-breaker)
+ * 3. Minimizes distance to food (tie-breaker), unless it is the first step of
+ *    a food path that ends in a trap (evals->trap_step)
+ *
+ * A move into an articulation point of the free cells commits the snake to
+ * one side of it, so it is only adequate if the largest side still holds the
+ * snake's length.
  *
+ * @param controller AI controller
  * @param state Current game state
+ * @param evals This tick's move evaluations (filled on demand)
  * @param space_result Output parameter for space analysis of chosen move
  * @return Direction to move
  */
-Direction ai_space_maximization_strategy(GameState* state, SpaceAnalysis** space_result);
+Direction ai_space_maximization_strategy(AIController* controller, GameState* state,
+                                         MoveEvaluations* evals, SpaceAnalysis** space_result);
 
 #endif /* AI_CONTROLLER_H */
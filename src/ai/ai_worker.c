@@ -0,0 +1,208 @@
+#define _POSIX_C_SOURCE 200112L
+#include "ai_worker.h"
+#include "../utils/memory_tracker.h"
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <errno.h>
+
+/* A decision and the results it points to, copied out of the controller's arena */
+typedef struct {
+    AIDecision decision;
+    PathResult path_to_food;
+    SafetyResult safety_check;
+    PathResult safety_escape;
+    SafetyResult path_safety;
+    PathResult path_escape;
+    SpaceAnalysis space_analysis;
+} AIWorkerResult;
+
+struct AIWorker {
+    AIController* controller;       /* Used only on the worker thread */
+    GameState* snapshot;            /* Request: state to decide on */
+    Direction applied_move;         /* Request: move to report to the strategy first */
+    AIWorkerResult results[2];      /* Result of request n lives in results[n % 2] */
+    atomic_uint request_seq;        /* Latest request (written by the main thread) */
+    atomic_uint result_seq;         /* Latest finished request (written by the worker) */
+    unsigned int polled_seq;        /* Latest result handed out (main thread only) */
+    atomic_bool stop;
+    sem_t wake;
+    pthread_t thread;
+    bool wake_ready;
+    bool thread_started;
+};
+
+/* Copy a path result without its positions */
+static PathResult* ai_worker_copy_path(PathResult* dst, const PathResult* src) {
+    if (!src) {
+        return NULL;
+    }
+
+    *dst = *src;
+    dst->positions = NULL;
+    return dst;
+}
+
+/* Copy a safety result and its escape path */
+static SafetyResult* ai_worker_copy_safety(SafetyResult* dst, PathResult* escape,
+                                           const SafetyResult* src) {
+    if (!src) {
+        return NULL;
+    }
+
+    *dst = *src;
+    dst->escape_path = ai_worker_copy_path(escape, src->escape_path);
+    return dst;
+}
+
+/* Copy a decision out of the arena, which the next decision recycles */
+static void ai_worker_store_result(AIWorkerResult* out, const AIDecision* decision) {
+    if (!decision) {
+        /* Allocation failed: no move, the snake keeps its direction */
+        out->decision = (AIDecision){0};
+        out->decision.chosen_direction = DIR_NONE;
+        return;
+    }
+
+    out->decision = *decision;
+    out->decision.path_to_food = ai_worker_copy_path(&out->path_to_food, decision->path_to_food);
+    out->decision.safety_check = ai_worker_copy_safety(&out->safety_check, &out->safety_escape,
+                                                       decision->safety_check);
+    out->decision.path_safety = ai_worker_copy_safety(&out->path_safety, &out->path_escape,
+                                                      decision->path_safety);
+    if (decision->space_analysis) {
+        out->space_analysis = *decision->space_analysis;
+        out->decision.space_analysis = &out->space_analysis;
+    }
+}
+
+static void* ai_worker_main(void* arg) {
+    AIWorker* worker = (AIWorker*)arg;
+
+    for (;;) {
+        while (sem_wait(&worker->wake) != 0 && errno == EINTR) {
+            /* Interrupted by a signal (SIGINT is handled): wait again */
+        }
+
+        if (atomic_load_explicit(&worker->stop, memory_order_acquire)) {
+            break;
+        }
+
+        /* Acquire: the snapshot and applied move written before the request are visible */
+        unsigned int seq = atomic_load_explicit(&worker->request_seq, memory_order_acquire);
+        if (seq == atomic_load_explicit(&worker->result_seq, memory_order_relaxed)) {
+            continue;  /* Already answered */
+        }
+
+        if (worker->applied_move != DIR_NONE) {
+            ai_controller_on_move(worker->controller, worker->snapshot, worker->applied_move);
+        }
+
+        AIDecision* decision = ai_make_decision(worker->controller, worker->snapshot);
+        ai_worker_store_result(&worker->results[seq % 2], decision);
+
+        /* Release: the result is complete, and the snapshot is free for the next request */
+        atomic_store_explicit(&worker->result_seq, seq, memory_order_release);
+    }
+
+    return NULL;
+}
+
+AIWorker* ai_worker_create(AIController* controller, int width, int height) {
+    if (!controller) {
+        return NULL;
+    }
+
+    AIWorker* worker = (AIWorker*)memory_tracked_malloc(sizeof(AIWorker));
+    if (!worker) {
+        ai_controller_destroy(controller);
+        return NULL;
+    }
+
+    worker->controller = controller;
+    worker->applied_move = DIR_NONE;
+    worker->polled_seq = 0;
+    worker->wake_ready = false;
+    worker->thread_started = false;
+    atomic_init(&worker->request_seq, 0);
+    atomic_init(&worker->result_seq, 0);
+    atomic_init(&worker->stop, false);
+
+    worker->snapshot = game_state_create(MODE_AI_DEMO, width, height, 0);
+    if (!worker->snapshot) {
+        ai_worker_destroy(worker);
+        return NULL;
+    }
+
+    worker->wake_ready = (sem_init(&worker->wake, 0, 0) == 0);
+    if (!worker->wake_ready) {
+        ai_worker_destroy(worker);
+        return NULL;
+    }
+
+    worker->thread_started = (pthread_create(&worker->thread, NULL, ai_worker_main, worker) == 0);
+    if (!worker->thread_started) {
+        ai_worker_destroy(worker);
+        return NULL;
+    }
+
+    return worker;
+}
+
+void ai_worker_destroy(AIWorker* worker) {
+    if (!worker) {
+        return;
+    }
+
+    if (worker->thread_started) {
+        atomic_store_explicit(&worker->stop, true, memory_order_release);
+        sem_post(&worker->wake);
+        pthread_join(worker->thread, NULL);
+    }
+
+    if (worker->wake_ready) {
+        sem_destroy(&worker->wake);
+    }
+
+    game_state_destroy(worker->snapshot);
+    ai_controller_destroy(worker->controller);
+    memory_tracked_free(worker);
+}
+
+bool ai_worker_request(AIWorker* worker, const GameState* state, Direction applied_move) {
+    if (!worker || !state) {
+        return false;
+    }
+
+    /* Only this thread writes request_seq */
+    unsigned int seq = atomic_load_explicit(&worker->request_seq, memory_order_relaxed);
+
+    /* Acquire: once the worker has answered, it no longer reads the snapshot */
+    if (atomic_load_explicit(&worker->result_seq, memory_order_acquire) != seq) {
+        return false;
+    }
+
+    if (game_state_copy(worker->snapshot, state) != SUCCESS) {
+        return false;
+    }
+    worker->applied_move = applied_move;
+
+    atomic_store_explicit(&worker->request_seq, seq + 1, memory_order_release);
+    sem_post(&worker->wake);
+    return true;
+}
+
+const AIDecision* ai_worker_poll(AIWorker* worker) {
+    if (!worker) {
+        return NULL;
+    }
+
+    unsigned int seq = atomic_load_explicit(&worker->request_seq, memory_order_relaxed);
+    if (worker->polled_seq == seq ||
+        atomic_load_explicit(&worker->result_seq, memory_order_acquire) != seq) {
+        return NULL;
+    }
+
+    worker->polled_seq = seq;
+    return &worker->results[seq % 2].decision;
+}
@@ -0,0 +1,70 @@
+#ifndef AI_WORKER_H
+#define AI_WORKER_H
+
+#include "../../include/common.h"
+#include "../game/game_state.h"
+#include "ai_controller.h"
+
+/**
+ * AI Worker Module
+ *
+ * Runs ai_make_decision on a dedicated thread, so the frame loop renders and
+ * sleeps while the next move is computed instead of adding decision latency
+ * to the frame time.
+ *
+ * Handoff between the frame loop (main thread) and the worker, one producer
+ * and one consumer in each direction, without locks:
+ * - Request: the main thread copies the live state into the worker's private
+ *   snapshot and publishes a new sequence number. It only does so while the
+ *   worker is idle, so the snapshot is never written while it is searched.
+ * - Result: the worker copies the decision into one of two result buffers
+ *   (by sequence number) and publishes that number. The frame loop can go on
+ *   drawing the previous result from the other buffer while the next one is
+ *   written.
+ * Sequence numbers are C11 atomics (release on publish, acquire on read); a
+ * semaphore only wakes the idle worker.
+ *
+ * One worker serves one frame loop: ai_worker_request and ai_worker_poll must
+ * be called from the same thread.
+ */
+typedef struct AIWorker AIWorker;
+
+/**
+ * Start a worker thread around an AI controller
+ * @param controller Configured controller; owned by the worker from now on
+ *                   (also on failure) and only used on the worker thread
+ * @param width Board width in cells
+ * @param height Board height in cells
+ * @return Pointer to new worker or NULL on failure
+ */
+AIWorker* ai_worker_create(AIController* controller, int width, int height);
+
+/**
+ * Stop the worker thread (after its current decision) and free everything
+ * @param worker Worker to destroy
+ */
+void ai_worker_destroy(AIWorker* worker);
+
+/**
+ * Ask for a decision on a snapshot of the current state
+ * A request made while the worker is still busy (e.g. with a decision the
+ * caller abandoned after a restart) is refused; try again next frame.
+ * @param worker Worker
+ * @param state Live game state (copied; the caller may change it right away)
+ * @param applied_move Move applied since the previous request, passed to
+ *                     ai_controller_on_move (DIR_NONE after a restart)
+ * @return true if the request was accepted
+ */
+bool ai_worker_request(AIWorker* worker, const GameState* state, Direction applied_move);
+
+/**
+ * Collect the decision for the latest request
+ * The decision and its path, safety and space results are copies owned by
+ * the worker; path positions are not copied (positions is NULL). Valid until
+ * the request after next.
+ * @param worker Worker
+ * @return Decision once ready (returned once), NULL while still computing
+ */
+const AIDecision* ai_worker_poll(AIWorker* worker);
+
+#endif /* AI_WORKER_H */
@@ -0,0 +1,262 @@
+#include "chokepoint_analyzer.h"
+#include "../utils/memory_tracker.h"
+#include <stdlib.h>
+
+ChokepointMap* chokepoint_map_create(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return NULL;
+    }
+
+    ChokepointMap* map = (ChokepointMap*)memory_tracked_malloc(sizeof(ChokepointMap));
+    if (!map) {
+        return NULL;
+    }
+
+    size_t cells = (size_t)width * (size_t)height;
+    map->cell_count = cells;
+    map->order = (uint32_t*)memory_tracked_calloc(cells, sizeof(uint32_t));
+    map->low = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cells);
+    map->parent = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cells);
+    map->subtree = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cells);
+    map->cut_cells = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cells);
+    map->region = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cells);
+    map->region_size = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cells);
+    map->beyond = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cells);
+    map->next_dir = (uint8_t*)memory_tracked_malloc(sizeof(uint8_t) * cells);
+    map->pieces = (uint8_t*)memory_tracked_malloc(sizeof(uint8_t) * cells);
+    map->stack = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cells);
+    map->members = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cells);
+
+    if (!map->order || !map->low || !map->parent || !map->subtree || !map->cut_cells ||
+        !map->region || !map->region_size || !map->beyond ||
+        !map->next_dir || !map->pieces || !map->stack || !map->members) {
+        chokepoint_map_destroy(map);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < cells; i++) {
+        map->region[i] = CHOKEPOINT_NONE;
+    }
+
+    return map;
+}
+
+void chokepoint_map_destroy(ChokepointMap* map) {
+    if (!map) {
+        return;
+    }
+
+    memory_tracked_free(map->order);
+    memory_tracked_free(map->low);
+    memory_tracked_free(map->parent);
+    memory_tracked_free(map->subtree);
+    memory_tracked_free(map->cut_cells);
+    memory_tracked_free(map->region);
+    memory_tracked_free(map->region_size);
+    memory_tracked_free(map->beyond);
+    memory_tracked_free(map->next_dir);
+    memory_tracked_free(map->pieces);
+    memory_tracked_free(map->stack);
+    memory_tracked_free(map->members);
+    memory_tracked_free(map);
+}
+
+/* Discover a cell: fresh DFS state, pushed on the stack */
+static void chokepoint_discover(ChokepointMap* map, uint32_t cell, uint32_t parent,
+                                uint32_t order, size_t* depth, size_t* count) {
+    map->order[cell] = order;
+    map->low[cell] = order;
+    map->parent[cell] = parent;
+    map->subtree[cell] = 1;
+    map->cut_cells[cell] = 0;
+    map->beyond[cell] = 0;
+    map->next_dir[cell] = DIR_UP;
+    map->pieces[cell] = 0;
+    map->stack[(*depth)++] = cell;
+    map->members[(*count)++] = cell;
+}
+
+/*
+ * Tarjan's DFS over one region, iterative (regions can span the whole
+ * board). When a child's subtree cannot reach above its parent (low >=
+ * order of the parent), removing the parent cuts that subtree off: it is
+ * recorded as one piece of the parent. Returns false if cut off at the
+ * deadline, leaving the region half analyzed.
+ */
+static bool chokepoint_analyze_region(ChokepointMap* map, const Grid* grid,
+                                      SearchWorkspace* workspace, uint32_t root) {
+    size_t depth = 0;
+    size_t count = 0;
+    uint32_t next_order = 1;
+
+    chokepoint_discover(map, root, CHOKEPOINT_NONE, next_order++, &depth, &count);
+
+    while (depth > 0) {
+        uint32_t cell = map->stack[depth - 1];
+
+        if (map->next_dir[cell] <= DIR_RIGHT) {
+            Direction dir = (Direction)map->next_dir[cell]++;
+            Position next = position_move(grid_position_of(grid, cell), dir);
+            if (!grid_is_walkable(grid, next)) {
+                continue;
+            }
+
+            uint32_t next_cell = (uint32_t)grid_index(grid, next);
+            if (map->order[next_cell] == 0) {
+                chokepoint_discover(map, next_cell, cell, next_order++, &depth, &count);
+                if (search_workspace_out_of_time(workspace, count)) {
+                    return false;
+                }
+            } else if (next_cell != map->parent[cell] && map->order[next_cell] < map->low[cell]) {
+                map->low[cell] = map->order[next_cell];
+            }
+            continue;
+        }
+
+        /* All neighbors done: report to the parent */
+        depth--;
+        uint32_t parent = map->parent[cell];
+        if (parent == CHOKEPOINT_NONE) {
+            continue;
+        }
+
+        map->subtree[parent] += map->subtree[cell];
+        if (map->low[cell] < map->low[parent]) {
+            map->low[parent] = map->low[cell];
+        }
+
+        if (map->low[cell] >= map->order[parent]) {
+            map->pieces[parent]++;
+            map->cut_cells[parent] += map->subtree[cell];
+            if (map->subtree[cell] > map->beyond[parent]) {
+                map->beyond[parent] = map->subtree[cell];
+            }
+        }
+    }
+
+    /* The region is complete: settle each cell's region, pieces and space beyond */
+    uint32_t size = map->subtree[root];
+    map->region_size[root] = size;
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t cell = map->members[i];
+        map->region[cell] = root;
+
+        /* Cells that stay connected to the DFS ancestors when this one is removed */
+        uint32_t remainder = size - 1 - map->cut_cells[cell];
+        if (remainder > 0) {
+            map->pieces[cell]++;
+            if (remainder > map->beyond[cell]) {
+                map->beyond[cell] = remainder;
+            }
+        }
+    }
+
+    return true;
+}
+
+/* Analyze every free cell not covered by an analysis yet */
+static bool chokepoint_analyze_pending(ChokepointMap* map, const Grid* grid,
+                                       SearchWorkspace* workspace) {
+    for (size_t cell = 0; cell < map->cell_count; cell++) {
+        if (map->order[cell] == 0 && grid_is_walkable(grid, grid_position_of(grid, cell)) &&
+            !chokepoint_analyze_region(map, grid, workspace, (uint32_t)cell)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool chokepoint_map_analyze(ChokepointMap* map, const Grid* grid, SearchWorkspace* workspace) {
+    if (!map || !grid || !workspace || grid_cell_count(grid) != map->cell_count) {
+        return false;
+    }
+
+    for (size_t cell = 0; cell < map->cell_count; cell++) {
+        map->order[cell] = 0;
+        map->region[cell] = CHOKEPOINT_NONE;
+    }
+
+    return chokepoint_analyze_pending(map, grid, workspace);
+}
+
+/*
+ * Forget the analysis of the region holding a cell, walking it by its
+ * labels. Returns false if cut off at the deadline, leaving the region
+ * half forgotten.
+ */
+static bool chokepoint_forget_region(ChokepointMap* map, const Grid* grid,
+                                     SearchWorkspace* workspace, uint32_t start) {
+    uint32_t region = map->region[start];
+    if (region == CHOKEPOINT_NONE) {
+        return true;
+    }
+
+    size_t depth = 0;
+    size_t forgotten = 1;
+    map->region[start] = CHOKEPOINT_NONE;
+    map->order[start] = 0;
+    map->stack[depth++] = start;
+
+    while (depth > 0) {
+        Position pos = grid_position_of(grid, map->stack[--depth]);
+        for (int d = DIR_UP; d <= DIR_RIGHT; d++) {
+            Position next = position_move(pos, (Direction)d);
+            if (!grid_is_valid_position(grid, next)) {
+                continue;
+            }
+
+            uint32_t next_cell = (uint32_t)grid_index(grid, next);
+            if (map->region[next_cell] == region) {
+                map->region[next_cell] = CHOKEPOINT_NONE;
+                map->order[next_cell] = 0;
+                map->stack[depth++] = next_cell;
+                if (search_workspace_out_of_time(workspace, ++forgotten)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+ * A region that loses a cell splits into pieces that each border that cell,
+ * and a freed cell merges the regions around it, so every new region holds a
+ * changed cell or one of its neighbors. Forget the regions touching the
+ * changed cells, then run the DFS over them again from those cells: the cost
+ * is the size of those regions, which on an open board is the whole board.
+ */
+bool chokepoint_map_update(ChokepointMap* map, const Grid* grid, SearchWorkspace* workspace,
+                           const Position* changed, size_t changed_count) {
+    if (!map || !grid || !workspace || !changed || grid_cell_count(grid) != map->cell_count) {
+        return false;
+    }
+
+    for (size_t i = 0; i < changed_count; i++) {
+        for (int d = DIR_NONE; d <= DIR_RIGHT; d++) {
+            Position pos = position_move(changed[i], (Direction)d);
+            if (grid_is_valid_position(grid, pos) &&
+                !chokepoint_forget_region(map, grid, workspace, (uint32_t)grid_index(grid, pos))) {
+                return false;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < changed_count; i++) {
+        for (int d = DIR_NONE; d <= DIR_RIGHT; d++) {
+            Position pos = position_move(changed[i], (Direction)d);
+            if (!grid_is_walkable(grid, pos)) {
+                continue;
+            }
+
+            uint32_t cell = (uint32_t)grid_index(grid, pos);
+            if (map->order[cell] == 0 && !chokepoint_analyze_region(map, grid, workspace, cell)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
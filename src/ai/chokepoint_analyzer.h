@@ -0,0 +1,110 @@
+#ifndef CHOKEPOINT_ANALYZER_H
+#define CHOKEPOINT_ANALYZER_H
+
+#include "../../include/common.h"
+#include "../data_structures/grid.h"
+#include "search_workspace.h"
+
+/* Marks a cell with no region (blocked, or not analyzed yet) */
+#define CHOKEPOINT_NONE UINT32_MAX
+
+/**
+ * Chokepoint Analyzer Module
+ *
+ * Articulation points of the free-cell graph (walkable cells,
+ * 4-connected), found by one iterative Tarjan DFS per
+ * region. An articulation point is a chokepoint: once the snake's head has
+ * passed through it, the region splits and only one side stays reachable.
+ * For every free cell the map records the largest region left after entering
+ * and leaving that cell, so a move that would cut the snake off from the
+ * space it needs is rejected by lookup, without a flood fill per candidate.
+ *
+ * Between consecutive ticks only the new head (now blocked) and the vacated
+ * tail (now free) change; chokepoint_map_update re-runs the DFS over every
+ * region touching those cells. That is O(region), not a local repair: while
+ * the board is one open region it costs as much as a full analysis, and it
+ * only saves work once the board has split into separate regions.
+ *
+ * Both passes stop at the workspace deadline (see search_workspace.h). A
+ * pass cut off that way leaves the map unusable until the next complete
+ * chokepoint_map_analyze.
+ *
+ * Per-cell arrays are indexed by grid_index. A map must not be shared
+ * between threads.
+ */
+typedef struct {
+    uint32_t* order;        /* DFS discovery number within the region (0 = not analyzed) */
+    uint32_t* low;          /* Lowest discovery number reachable from the DFS subtree */
+    uint32_t* parent;       /* DFS parent cell (CHOKEPOINT_NONE at a root) */
+    uint32_t* subtree;      /* Cells in the DFS subtree */
+    uint32_t* cut_cells;    /* Cells of the subtrees cut off when the cell is removed */
+    uint32_t* region;       /* Region id (its DFS root cell), CHOKEPOINT_NONE if blocked */
+    uint32_t* region_size;  /* Cells per region, indexed by region id */
+    uint32_t* beyond;       /* Largest region left after entering and leaving the cell */
+    uint8_t* next_dir;      /* DFS iteration state: next neighbor to visit */
+    uint8_t* pieces;        /* Regions the cell's removal leaves behind */
+    uint32_t* stack;        /* DFS stack */
+    uint32_t* members;      /* Cells of the region being analyzed, in discovery order */
+    size_t cell_count;
+} ChokepointMap;
+
+/**
+ * Create a map for a board size
+ * @param width Board width in cells
+ * @param height Board height in cells
+ * @return Pointer to new map or NULL on failure
+ */
+ChokepointMap* chokepoint_map_create(int width, int height);
+
+/**
+ * Destroy map and free its arrays
+ * @param map Map to destroy
+ */
+void chokepoint_map_destroy(ChokepointMap* map);
+
+/**
+ * Analyze every region of the grid
+ * O(cells): one DFS visit per free cell
+ * @param map Map sized for the grid
+ * @param grid Current grid
+ * @param workspace Workspace whose deadline bounds the pass
+ * @return true if the analysis is complete, false if cut off at the deadline
+ */
+bool chokepoint_map_analyze(ChokepointMap* map, const Grid* grid, SearchWorkspace* workspace);
+
+/**
+ * Bring the analysis up to date after some cells changed walkability
+ * Regions holding or bordering a changed cell are analyzed again in full,
+ * O(cells of those regions); all other regions keep their results.
+ * Requires a previous analysis of the grid as it was before the changes.
+ * @param map Map with a previous analysis
+ * @param grid Current grid
+ * @param workspace Workspace whose deadline bounds the pass
+ * @param changed Cells whose walkability may have changed
+ * @param changed_count Number of changed cells
+ * @return true if the analysis is complete, false if cut off at the deadline
+ */
+bool chokepoint_map_update(ChokepointMap* map, const Grid* grid, SearchWorkspace* workspace,
+                           const Position* changed, size_t changed_count);
+
+/**
+ * Check if a free cell is an articulation point (chokepoint)
+ * @param map Analyzed map
+ * @param cell Cell index
+ * @return true if removing the cell splits its region
+ */
+static inline bool chokepoint_is_articulation(const ChokepointMap* map, size_t cell) {
+    return map->region[cell] != CHOKEPOINT_NONE && map->pieces[cell] >= 2;
+}
+
+/**
+ * Largest region reachable after the head enters a free cell and moves on
+ * @param map Analyzed map
+ * @param cell Cell index
+ * @return Cells on the largest side, 0 for blocked cells
+ */
+static inline size_t chokepoint_space_beyond(const ChokepointMap* map, size_t cell) {
+    return map->region[cell] != CHOKEPOINT_NONE ? map->beyond[cell] : 0;
+}
+
+#endif /* CHOKEPOINT_ANALYZER_H */
@@ -0,0 +1,194 @@
+#include "hamiltonian.h"
+#include "pathfinding.h"
+#include "../utils/memory_tracker.h"
+#include <stdlib.h>
+
+/* Free cells kept between the head's landing cell and the tail */
+#define SHORTCUT_EMPTY_BUFFER 3
+
+/* Extra margin when the food lies between head and tail on the tour */
+#define SHORTCUT_CROWDED_PENALTY 10
+
+/* Cell index of tour coordinates; `transposed` swaps the roles of x and y */
+static size_t tour_cell(int width, bool transposed, int major, int minor) {
+    return transposed ? (size_t)major * (size_t)width + (size_t)minor
+                      : (size_t)minor * (size_t)width + (size_t)major;
+}
+
+HamiltonianCycle* hamiltonian_cycle_create(int width, int height) {
+    if (width < 2 || height < 2 || !hamiltonian_cycle_exists(width, height)) {
+        return NULL;
+    }
+
+    HamiltonianCycle* cycle = (HamiltonianCycle*)memory_tracked_malloc(sizeof(HamiltonianCycle));
+    if (!cycle) {
+        return NULL;
+    }
+
+    size_t cell_count = (size_t)width * (size_t)height;
+
+    cycle->width = width;
+    cycle->height = height;
+    cycle->cell_count = cell_count;
+    cycle->order = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cell_count);
+    cycle->cells = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cell_count);
+
+    if (!cycle->order || !cycle->cells) {
+        hamiltonian_cycle_destroy(cycle);
+        return NULL;
+    }
+
+    /*
+     * Tour for an even number of rows (columns when transposed):
+     * 1. Row 0 left to right
+     * 2. Rows 1..rows-1 serpentine over columns 1..cols-1, starting right
+     * 3. Column 0 bottom to top, back to the start
+     * An even row count makes the serpentine end next to column 0.
+     */
+    bool transposed = (height % 2 != 0);
+    int cols = transposed ? height : width;
+    int rows = transposed ? width : height;
+    size_t step = 0;
+
+    for (int c = 0; c < cols; c++) {
+        cycle->cells[step++] = (uint32_t)tour_cell(width, transposed, c, 0);
+    }
+
+    for (int r = 1; r < rows; r++) {
+        for (int i = 1; i < cols; i++) {
+            int c = (r % 2 == 1) ? cols - i : i;
+            cycle->cells[step++] = (uint32_t)tour_cell(width, transposed, c, r);
+        }
+    }
+
+    for (int r = rows - 1; r >= 1; r--) {
+        cycle->cells[step++] = (uint32_t)tour_cell(width, transposed, 0, r);
+    }
+
+    for (size_t i = 0; i < cell_count; i++) {
+        cycle->order[cycle->cells[i]] = (uint32_t)i;
+    }
+
+    return cycle;
+}
+
+void hamiltonian_cycle_destroy(HamiltonianCycle* cycle) {
+    if (!cycle) {
+        return;
+    }
+
+    memory_tracked_free(cycle->order);
+    memory_tracked_free(cycle->cells);
+    memory_tracked_free(cycle);
+}
+
+/*
+ * Whether the body lies in tour order behind the head: walking from the head
+ * to the tail, each segment is strictly closer to the tail along the tour.
+ * Moves made off the tour (the space pipeline, before the snake joins it)
+ * can leave segments ahead of the head, where a shortcut would run into them.
+ */
+static bool body_in_tour_order(const HamiltonianCycle* cycle, const Grid* grid,
+                               const Snake* snake) {
+    size_t tail_cell = grid_index(grid, snake_tail(snake));
+    size_t previous = cycle->cell_count;
+
+    for (size_t i = 0; i < snake->length; i++) {
+        size_t distance = hamiltonian_distance(cycle, tail_cell,
+                                               grid_index(grid, snake_get_segment(snake, i)));
+        if (distance >= previous) {
+            return false;
+        }
+        previous = distance;
+    }
+
+    return true;
+}
+
+/*
+ * How many tour steps the head may skip this move
+ *
+ * Landing d steps ahead is safe while d stays below the tail's distance,
+ * less a buffer for the cells the snake grows into before the tail moves.
+ * The allowance is capped at the food's distance so the snake never
+ * overshoots it, and is zero once free space drops below half the board or
+ * while the body is out of tour order.
+ */
+static size_t shortcut_allowance(const HamiltonianCycle* cycle, const Grid* grid,
+                                 const Snake* snake, size_t head_cell) {
+    size_t free_cells = cycle->cell_count - snake->length;
+    if (free_cells < cycle->cell_count / 2) {
+        return 0;
+    }
+
+    size_t tail_distance = hamiltonian_distance(cycle, head_cell,
+                                                grid_index(grid, snake_tail(snake)));
+    long allowance = (long)tail_distance - (long)SHORTCUT_EMPTY_BUFFER;
+
+    if (!grid_is_valid_position(grid, grid->food_pos)) {
+        return 0;  /* No food to hurry toward */
+    }
+
+    size_t food_distance = hamiltonian_distance(cycle, head_cell, grid_index(grid, grid->food_pos));
+
+    if (food_distance < tail_distance) {
+        /* Eating before the tail moves grows the snake into the gap */
+        allowance -= 1;
+        if ((tail_distance - food_distance) * 4 > free_cells) {
+            allowance -= SHORTCUT_CROWDED_PENALTY;
+        }
+    }
+
+    if ((long)food_distance < allowance) {
+        allowance = (long)food_distance;
+    }
+
+    /* O(length), so checked only when a shortcut is on offer */
+    if (allowance <= 0 || !body_in_tour_order(cycle, grid, snake)) {
+        return 0;
+    }
+
+    return (size_t)allowance;
+}
+
+Direction hamiltonian_choose_move(const HamiltonianCycle* cycle, const Grid* grid, const Snake* snake) {
+    if (!cycle || !grid || !snake || (size_t)grid->width * (size_t)grid->height != cycle->cell_count) {
+        return DIR_NONE;
+    }
+
+    Position head = snake_head(snake);
+    size_t head_cell = grid_index(grid, head);
+    size_t allowance = shortcut_allowance(cycle, grid, snake, head_cell);
+
+    /* Furthest walkable neighbor within the allowance */
+    Direction best_dir = DIR_NONE;
+    size_t best_distance = 0;
+
+    Direction dirs[4] = {DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT};
+    for (int i = 0; i < 4; i++) {
+        Position next = position_move(head, dirs[i]);
+        if (!grid_is_walkable(grid, next)) {
+            continue;
+        }
+
+        size_t distance = hamiltonian_distance(cycle, head_cell, grid_index(grid, next));
+        if (distance <= allowance && distance > best_distance) {
+            best_dir = dirs[i];
+            best_distance = distance;
+        }
+    }
+
+    if (best_dir != DIR_NONE) {
+        return best_dir;
+    }
+
+    /* No shortcut: follow the tour */
+    size_t next_cell = cycle->cells[(cycle->order[head_cell] + 1) % cycle->cell_count];
+    Position next = grid_position_of(grid, next_cell);
+
+    if (!grid_is_walkable(grid, next)) {
+        return DIR_NONE;
+    }
+
+    return pathfinding_get_next_direction(head, next);
+}
@@ -0,0 +1,83 @@
+#ifndef HAMILTONIAN_H
+#define HAMILTONIAN_H
+
+#include "../../include/common.h"
+#include "../data_structures/grid.h"
+#include "../data_structures/snake.h"
+
+/**
+ * Hamiltonian Cycle Module
+ *
+ * A fixed tour that visits every board cell once and returns to the start.
+ * A snake that only ever moves to the next cell of the tour can never trap
+ * itself and always fills the board, so following the tour guarantees a
+ * perfect game.
+ *
+ * To reach food faster the snake may jump ahead along the tour (a shortcut)
+ * to a neighbor whose tour distance from the head is still less than that
+ * of the tail: every cell skipped is then free, and the body stays in tour
+ * order behind the head. Shortcuts are only taken while the body already
+ * lies in that order (not after moves made off the tour), keep a growth
+ * margin, and are disabled once the snake covers half of the board.
+ *
+ * A cycle exists only when width * height is even.
+ */
+typedef struct {
+    uint32_t* order;    /* Tour position of each cell (row-major index) */
+    uint32_t* cells;    /* Cell index at each tour position */
+    size_t cell_count;
+    int width;
+    int height;
+} HamiltonianCycle;
+
+/**
+ * Build a Hamiltonian cycle over a board
+ * Uses a serpentine tour with a return lane along one edge.
+ * @param width Board width in cells
+ * @param height Board height in cells
+ * @return Pointer to new cycle, or NULL if width * height is odd or on allocation failure
+ */
+HamiltonianCycle* hamiltonian_cycle_create(int width, int height);
+
+/**
+ * Destroy cycle and free its tables
+ * @param cycle Cycle to destroy
+ */
+void hamiltonian_cycle_destroy(HamiltonianCycle* cycle);
+
+/**
+ * Check whether a board admits the cycle built by hamiltonian_cycle_create
+ * @param width Board width in cells
+ * @param height Board height in cells
+ * @return true if width * height is even
+ */
+static inline bool hamiltonian_cycle_exists(int width, int height) {
+    return ((size_t)width * (size_t)height) % 2 == 0;
+}
+
+/**
+ * Get the number of tour steps from one cell to another
+ * @param cycle Cycle to measure along
+ * @param from_cell Start cell index
+ * @param to_cell Target cell index
+ * @return Steps forward along the tour (0 if the cells are equal)
+ */
+static inline size_t hamiltonian_distance(const HamiltonianCycle* cycle,
+                                          size_t from_cell, size_t to_cell) {
+    size_t from = cycle->order[from_cell];
+    size_t to = cycle->order[to_cell];
+    return (to >= from) ? to - from : to + cycle->cell_count - from;
+}
+
+/**
+ * Choose the next move: the furthest safe shortcut toward food, else the
+ * next cell of the tour
+ * @param cycle Cycle sized for the grid
+ * @param grid Current grid state
+ * @param snake Current snake
+ * @return Direction to move, or DIR_NONE if the next tour cell is blocked
+ *         (the body is not yet laid out along the tour, e.g. at game start)
+ */
+Direction hamiltonian_choose_move(const HamiltonianCycle* cycle, const Grid* grid, const Snake* snake);
+
+#endif /* HAMILTONIAN_H */
@@ -3,14 +3,45 @@
 #include "../utils/timer.h"
 #include "../utils/memory_tracker.h"
 #include <stdlib.h>
+#include <assert.h>
 
-PathResult* pathfinding_bfs(Grid* grid, Position start, Position goal) {
-    if (!grid) {
+/*
+ * Follow parent links from goal back to start and store the path in the
+ * result (start first). Backtracking fills the workspace path buffer, so
+ * only the final copy is allocated.
+ */
+static void pathfinding_reconstruct(const Grid* grid, SearchWorkspace* workspace,
+                                    Position start, Position goal, PathResult* result) {
+    size_t path_length = 0;
+    Position current = goal;
+    while (!position_equals(current, start)) {
+        workspace->path[path_length++] = current;
+        current = grid_position_of(grid, (size_t)grid->parent[grid_index(grid, current)]);
+    }
+    workspace->path[path_length++] = start;
+
+    /* Allocate path array */
+    result->positions = (Position*)memory_arena_alloc(
+        &workspace->results, sizeof(Position) * path_length);
+
+    if (result->positions) {
+        /* Copy out in start-to-goal order */
+        for (size_t i = 0; i < path_length; i++) {
+            result->positions[i] = workspace->path[path_length - 1 - i];
+        }
+
+        result->length = path_length;
+        result->found = true;
+    }
+}
+
+PathResult* pathfinding_bfs(Grid* grid, SearchWorkspace* workspace, Position start, Position goal) {
+    if (!grid || !workspace) {
         return NULL;
     }
 
     /* Allocate result */
-    PathResult* result = (PathResult*)memory_tracked_malloc(sizeof(PathResult));
+    PathResult* result = (PathResult*)memory_arena_alloc(&workspace->results, sizeof(PathResult));
     if (!result) {
         return NULL;
     }
@@ -19,6 +50,8 @@ PathResult* pathfinding_bfs(Grid* grid, Position start, Position goal) {
     result->length = 0;
     result->found = false;
     result->compute_time_us = 0;
+    result->nodes_expanded = 0;
+    result->timed_out = false;
 
     /* Start timing */
     Timer timer;
@@ -27,29 +60,30 @@ PathResult* pathfinding_bfs(Grid* grid, Position start, Position goal) {
     /* Reset pathfinding fields in grid */
     grid_reset_pathfinding(grid);
 
-    /* Create queue for BFS */
-    Queue* queue = queue_create(QUEUE_CAPACITY);
-    if (!queue) {
-        memory_tracked_free(result);
-        return NULL;
-    }
+    /* Reuse the workspace frontier (sized for the entire grid + 1) */
+    Queue* queue = workspace->frontier;
+    queue_clear(queue);
 
     /* Initialize BFS */
-    grid->cells[start.y][start.x].visited = true;
-    grid->cells[start.y][start.x].distance = 0;
-    grid->cells[start.y][start.x].parent = (Position){-1, -1};
+    grid_mark_visited(grid, grid_index(grid, start), 0, -1);
     queue_enqueue(queue, start, 0);
 
     bool path_found = false;
 
     /* BFS main loop */
     while (!queue_is_empty(queue)) {
+        if (search_workspace_out_of_time(workspace, result->nodes_expanded)) {
+            result->timed_out = true;
+            break;
+        }
+
         QueueNode current_node;
         if (queue_dequeue(queue, &current_node) != SUCCESS) {
             break;
         }
 
         Position current = current_node.pos;
+        result->nodes_expanded++;
 
         /* Check if we reached the goal */
         if (position_equals(current, goal)) {
@@ -60,19 +94,19 @@ PathResult* pathfinding_bfs(Grid* grid, Position start, Position goal) {
         /* Explore neighbors */
         Position neighbors[4];
         int neighbor_count;
-        grid_get_neighbors(current, neighbors, &neighbor_count);
+        grid_get_neighbors(grid, current, neighbors, &neighbor_count);
 
         for (int i = 0; i < neighbor_count; i++) {
             Position next = neighbors[i];
 
+            size_t next_index = grid_index(grid, next);
+
             /* Check if walkable and not visited */
-            if (grid_is_walkable(grid, next) &&
-                !grid->cells[next.y][next.x].visited) {
+            if (grid_is_walkable(grid, next) && !grid_is_visited(grid, next_index)) {
 
                 /* Mark as visited */
-                grid->cells[next.y][next.x].visited = true;
-                grid->cells[next.y][next.x].distance = current_node.distance + 1;
-                grid->cells[next.y][next.x].parent = current;
+                grid_mark_visited(grid, next_index, current_node.distance + 1,
+                                  (int32_t)grid_index(grid, current));
 
                 /* Enqueue */
                 queue_enqueue(queue, next, current_node.distance + 1);
@@ -82,54 +116,325 @@ PathResult* pathfinding_bfs(Grid* grid, Position start, Position goal) {
 
     /* Reconstruct path if found */
     if (path_found) {
-        /* Count path length by backtracking */
-        size_t path_length = 0;
-        Position current = goal;
-        while (!position_equals(current, start)) {
-            path_length++;
-            current = grid->cells[current.y][current.x].parent;
+        pathfinding_reconstruct(grid, workspace, start, goal, result);
+    }
+
+    /* Stop timing */
+    timer_stop(&timer);
+    result->compute_time_us = timer_elapsed_us(&timer);
+
+    return result;
+}
+
+/* Manhattan distance: admissible and consistent on a 4-connected grid */
+static inline uint32_t manhattan_distance(Position a, Position b) {
+    return (uint32_t)(abs(a.x - b.x) + abs(a.y - b.y));
+}
+
+/*
+ * Open-set order: lower f first; on ties prefer the deeper node, which is
+ * closer to the goal and lets A* run straight down one of many equal paths
+ */
+static inline bool heap_before(const Grid* grid, SearchHeapNode a, SearchHeapNode b) {
+    if (a.f_score != b.f_score) {
+        return a.f_score < b.f_score;
+    }
+    return grid->distance[a.cell] > grid->distance[b.cell];
+}
+
+static void heap_place(SearchWorkspace* workspace, size_t slot, SearchHeapNode node) {
+    workspace->heap[slot] = node;
+    workspace->heap_pos[node.cell] = (uint32_t)slot;
+}
+
+static void heap_sift_up(const Grid* grid, SearchWorkspace* workspace, size_t slot) {
+    SearchHeapNode node = workspace->heap[slot];
+    while (slot > 0) {
+        size_t parent = (slot - 1) / 2;
+        if (!heap_before(grid, node, workspace->heap[parent])) {
+            break;
         }
-        path_length++; /* Include start position */
-
-        /* Allocate path array */
-        result->positions = (Position*)memory_tracked_malloc(
-            sizeof(Position) * path_length);
-
-        if (result->positions) {
-            /* Fill path array in reverse */
-            current = goal;
-            for (int i = (int)path_length - 1; i >= 0; i--) {
-                result->positions[i] = current;
-                if (!position_equals(current, start)) {
-                    current = grid->cells[current.y][current.x].parent;
-                }
+        heap_place(workspace, slot, workspace->heap[parent]);
+        slot = parent;
+    }
+    heap_place(workspace, slot, node);
+}
+
+static void heap_sift_down(const Grid* grid, SearchWorkspace* workspace, size_t slot) {
+    SearchHeapNode node = workspace->heap[slot];
+    size_t size = workspace->heap_size;
+    for (;;) {
+        size_t child = 2 * slot + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && heap_before(grid, workspace->heap[child + 1], workspace->heap[child])) {
+            child++;
+        }
+        if (!heap_before(grid, workspace->heap[child], node)) {
+            break;
+        }
+        heap_place(workspace, slot, workspace->heap[child]);
+        slot = child;
+    }
+    heap_place(workspace, slot, node);
+}
+
+static void heap_push(const Grid* grid, SearchWorkspace* workspace, size_t cell, uint32_t f_score) {
+    size_t slot = workspace->heap_size++;
+    workspace->heap[slot] = (SearchHeapNode){(uint32_t)cell, f_score};
+    heap_sift_up(grid, workspace, slot);
+}
+
+static SearchHeapNode heap_pop(const Grid* grid, SearchWorkspace* workspace) {
+    SearchHeapNode top = workspace->heap[0];
+    workspace->heap_pos[top.cell] = SEARCH_HEAP_CLOSED;
+
+    workspace->heap_size--;
+    if (workspace->heap_size > 0) {
+        workspace->heap[0] = workspace->heap[workspace->heap_size];
+        heap_sift_down(grid, workspace, 0);
+    }
+
+    return top;
+}
+
+PathResult* pathfinding_astar(Grid* grid, SearchWorkspace* workspace, Position start, Position goal) {
+    if (!grid || !workspace) {
+        return NULL;
+    }
+
+    /* Allocate result */
+    PathResult* result = (PathResult*)memory_arena_alloc(&workspace->results, sizeof(PathResult));
+    if (!result) {
+        return NULL;
+    }
+
+    result->positions = NULL;
+    result->length = 0;
+    result->found = false;
+    result->compute_time_us = 0;
+    result->nodes_expanded = 0;
+    result->timed_out = false;
+
+    /* Start timing */
+    Timer timer;
+    timer_start(&timer);
+
+    bool path_found = false;
+
+    /* An off-board goal (no food) can never be reached */
+    if (grid_is_valid_position(grid, start) && grid_is_valid_position(grid, goal)) {
+        /* Reset pathfinding fields in grid */
+        grid_reset_pathfinding(grid);
+        workspace->heap_size = 0;
+
+        size_t goal_cell = grid_index(grid, goal);
+        size_t start_cell = grid_index(grid, start);
+        grid_mark_visited(grid, start_cell, 0, -1);
+        heap_push(grid, workspace, start_cell, manhattan_distance(start, goal));
+
+        /* A* main loop: the consistent heuristic means a cell's distance is final when popped */
+        while (workspace->heap_size > 0) {
+            if (search_workspace_out_of_time(workspace, result->nodes_expanded)) {
+                result->timed_out = true;
+                break;
+            }
+
+            SearchHeapNode node = heap_pop(grid, workspace);
+            result->nodes_expanded++;
+
+            if (node.cell == goal_cell) {
+                path_found = true;
+                break;
             }
 
-            result->length = path_length;
-            result->found = true;
+            Position current = grid_position_of(grid, node.cell);
+            int32_t next_distance = grid->distance[node.cell] + 1;
+
+            /* Explore neighbors */
+            Position neighbors[4];
+            int neighbor_count;
+            grid_get_neighbors(grid, current, neighbors, &neighbor_count);
+
+            for (int i = 0; i < neighbor_count; i++) {
+                Position next = neighbors[i];
+                if (!grid_is_walkable(grid, next)) {
+                    continue;
+                }
+
+                size_t next_index = grid_index(grid, next);
+                uint32_t f_score = (uint32_t)next_distance + manhattan_distance(next, goal);
+
+                if (!grid_is_visited(grid, next_index)) {
+                    /* First discovery */
+                    grid_mark_visited(grid, next_index, next_distance, (int32_t)node.cell);
+                    heap_push(grid, workspace, next_index, f_score);
+                } else if (workspace->heap_pos[next_index] != SEARCH_HEAP_CLOSED &&
+                           next_distance < grid->distance[next_index]) {
+                    /* Shorter route to an open cell: decrease its key */
+                    grid->distance[next_index] = next_distance;
+                    grid->parent[next_index] = (int32_t)node.cell;
+
+                    size_t slot = workspace->heap_pos[next_index];
+                    workspace->heap[slot].f_score = f_score;
+                    heap_sift_up(grid, workspace, slot);
+                }
+            }
         }
     }
 
-    /* Cleanup */
-    queue_destroy(queue);
+    /* Reconstruct path if found */
+    if (path_found) {
+        pathfinding_reconstruct(grid, workspace, start, goal, result);
+    }
 
     /* Stop timing */
     timer_stop(&timer);
     result->compute_time_us = timer_elapsed_us(&timer);
 
+#ifdef OUROBOROS_DEBUG_CHECKS
+    /* Cross-check: A* must find a path exactly when BFS does, of the same length */
+    PathResult* reference = pathfinding_bfs(grid, workspace, start, goal);
+    if (reference && !reference->timed_out && !result->timed_out) {
+        assert(reference->found == result->found);
+        assert(reference->length == result->length);
+    }
+#endif
+
     return result;
 }
 
-void pathfinding_free_result(PathResult* result) {
+/*
+ * Can the head enter `pos` on move `arrival`? Free cells always; a body
+ * cell once its segment has left (segment i leaves after length - i moves).
+ */
+static inline bool timed_is_passable(const Grid* grid, const Snake* snake,
+                                     Position pos, int32_t arrival) {
+    if (grid_is_walkable(grid, pos)) {
+        return true;
+    }
+
+    int segment = snake_get_segment_at(snake, pos);
+    return segment >= 0 && (size_t)arrival >= snake->length - (size_t)segment;
+}
+
+PathResult* pathfinding_bfs_timed(Grid* grid, SearchWorkspace* workspace, const Snake* snake,
+                                  Position goal) {
+    if (!grid || !workspace || !snake) {
+        return NULL;
+    }
+
+    /* Allocate result */
+    PathResult* result = (PathResult*)memory_arena_alloc(&workspace->results, sizeof(PathResult));
     if (!result) {
-        return;
+        return NULL;
     }
 
-    if (result->positions) {
-        memory_tracked_free(result->positions);
+    result->positions = NULL;
+    result->length = 0;
+    result->found = false;
+    result->compute_time_us = 0;
+    result->nodes_expanded = 0;
+    result->timed_out = false;
+
+    /* Start timing */
+    Timer timer;
+    timer_start(&timer);
+
+    Position start = snake_head(snake);
+
+    /* Reset pathfinding fields in grid */
+    grid_reset_pathfinding(grid);
+
+    /* Reuse the workspace frontier (sized for the entire grid + 1) */
+    Queue* queue = workspace->frontier;
+    queue_clear(queue);
+
+    grid_mark_visited(grid, grid_index(grid, start), 0, -1);
+    queue_enqueue(queue, start, 0);
+
+    bool path_found = false;
+
+    /*
+     * Same loop as pathfinding_bfs with a passability test that depends on
+     * the arrival time. A body cell that is still occupied when first seen
+     * stays unvisited, so a longer route can still enter it later; BFS
+     * order makes the first accepted arrival the earliest possible one.
+     */
+    while (!queue_is_empty(queue)) {
+        if (search_workspace_out_of_time(workspace, result->nodes_expanded)) {
+            result->timed_out = true;
+            break;
+        }
+
+        QueueNode current_node;
+        if (queue_dequeue(queue, &current_node) != SUCCESS) {
+            break;
+        }
+
+        Position current = current_node.pos;
+        result->nodes_expanded++;
+
+        if (position_equals(current, goal)) {
+            path_found = true;
+            break;
+        }
+
+        Position neighbors[4];
+        int neighbor_count;
+        grid_get_neighbors(grid, current, neighbors, &neighbor_count);
+
+        int32_t arrival = current_node.distance + 1;
+        for (int i = 0; i < neighbor_count; i++) {
+            Position next = neighbors[i];
+            size_t next_index = grid_index(grid, next);
+
+            if (!grid_is_visited(grid, next_index) && timed_is_passable(grid, snake, next, arrival)) {
+                grid_mark_visited(grid, next_index, arrival, (int32_t)grid_index(grid, current));
+                queue_enqueue(queue, next, arrival);
+            }
+        }
+    }
+
+    /* Reconstruct path if found */
+    if (path_found) {
+        pathfinding_reconstruct(grid, workspace, start, goal, result);
     }
 
-    memory_tracked_free(result);
+    /* Stop timing */
+    timer_stop(&timer);
+    result->compute_time_us = timer_elapsed_us(&timer);
+
+#ifdef OUROBOROS_DEBUG_CHECKS
+    /* Every step must be passable on arrival, and never longer than plain BFS */
+    for (size_t i = 1; result->found && i < result->length; i++) {
+        assert(timed_is_passable(grid, snake, result->positions[i], (int32_t)i));
+    }
+    PathResult* reference = pathfinding_bfs(grid, workspace, start, goal);
+    if (reference && reference->found && !result->timed_out) {
+        assert(result->found && result->length <= reference->length);
+    }
+#endif
+
+    return result;
+}
+
+PathResult* pathfinding_find_path(PathAlgorithm algorithm, Grid* grid, SearchWorkspace* workspace,
+                                  const Snake* snake, Position goal) {
+    if (!snake) {
+        return NULL;
+    }
+
+    switch (algorithm) {
+        case PATH_ALGORITHM_ASTAR:
+            return pathfinding_astar(grid, workspace, snake_head(snake), goal);
+        case PATH_ALGORITHM_TIMED_BFS:
+            return pathfinding_bfs_timed(grid, workspace, snake, goal);
+        case PATH_ALGORITHM_BFS:
+        default:
+            return pathfinding_bfs(grid, workspace, snake_head(snake), goal);
+    }
 }
 
 Direction pathfinding_get_next_direction(Position current, Position next) {
@@ -3,6 +3,8 @@
 
 #include "../../include/common.h"
 #include "../data_structures/grid.h"
+#include "../data_structures/snake.h"
+#include "search_workspace.h"
 
 /**
  * Path result structure
@@ -13,22 +15,58 @@ typedef struct {
     size_t length;            /* Number of positions in path */
     bool found;               /* Whether path was found */
     uint64_t compute_time_us; /* Computation time in microseconds */
+    size_t nodes_expanded;    /* Cells taken off the frontier/open set */
+    bool timed_out;           /* Gave up at the workspace deadline (found is false) */
 } PathResult;
 
 /**
  * Perform BFS pathfinding from start to goal
  * @param grid Grid to search (will be modified - pathfinding fields updated)
+ * @param workspace Scratch buffers for the search (frontier and path buffer)
  * @param start Start position
  * @param goal Goal position
- * @return PathResult with path data (must be freed with pathfinding_free_result)
+ * @return PathResult with path data, allocated from the workspace result arena
  */
-PathResult* pathfinding_bfs(Grid* grid, Position start, Position goal);
+PathResult* pathfinding_bfs(Grid* grid, SearchWorkspace* workspace, Position start, Position goal);
 
 /**
- * Free path result and associated data
- * @param result PathResult to free
+ * Perform A* pathfinding from start to goal
+ * Uses the Manhattan distance heuristic and a binary heap, so on open boards
+ * it expands far fewer cells than BFS; the path length is the same.
+ * @param grid Grid to search (will be modified - pathfinding fields updated)
+ * @param workspace Scratch buffers for the search (open-set heap and path buffer)
+ * @param start Start position
+ * @param goal Goal position
+ * @return PathResult with path data, allocated from the workspace result arena
+ */
+PathResult* pathfinding_astar(Grid* grid, SearchWorkspace* workspace, Position start, Position goal);
+
+/**
+ * Perform time-aware BFS from the snake's head to goal
+ * Body segment i (0 = head) leaves its cell after length - i moves, so the
+ * search may enter a body cell if the head reaches it no sooner than that.
+ * Finds routes through the body that plain BFS reports as blocked; valid
+ * while the snake does not grow on the way (true for a path to the food).
+ * @param grid Grid to search (will be modified - pathfinding fields updated)
+ * @param workspace Scratch buffers for the search (frontier and path buffer)
+ * @param snake Snake whose head starts the search
+ * @param goal Goal position
+ * @return PathResult with path data, allocated from the workspace result arena
+ */
+PathResult* pathfinding_bfs_timed(Grid* grid, SearchWorkspace* workspace, const Snake* snake,
+                                  Position goal);
+
+/**
+ * Find a shortest path from the snake's head with the chosen algorithm
+ * @param algorithm Search to run (see PathAlgorithm)
+ * @param grid Grid to search (will be modified - pathfinding fields updated)
+ * @param workspace Scratch buffers for the search
+ * @param snake Snake whose head starts the search
+ * @param goal Goal position
+ * @return PathResult with path data, allocated from the workspace result arena
  */
-void pathfinding_free_result(PathResult* result);
+PathResult* pathfinding_find_path(PathAlgorithm algorithm, Grid* grid, SearchWorkspace* workspace,
+                                  const Snake* snake, Position goal);
 
 /**
  * Get direction to move from current to next position
@@ -19,8 +19,9 @@
  *
  * This ensures every move maintains an escape route, preventing self-trapping.
  */
-SafetyResult* safety_check_move(Grid* grid, const Snake* snake, Direction move, Position food_pos) {
-    if (!grid || !snake || move == DIR_NONE) {
+SafetyResult* safety_check_move(Grid* grid, SearchWorkspace* workspace, const Snake* snake,
+                                Direction move, Position food_pos) {
+    if (!grid || !workspace || !snake || move == DIR_NONE) {
         return NULL;
     }
 
@@ -28,7 +29,8 @@ SafetyResult* safety_check_move(Grid* grid, const Snake* snake, Direction move,
     timer_start(&timer);
 
     /* Allocate result structure */
-    SafetyResult* result = (SafetyResult*)memory_tracked_malloc(sizeof(SafetyResult));
+    SafetyResult* result = (SafetyResult*)memory_arena_alloc(&workspace->results,
+                                                            sizeof(SafetyResult));
     if (!result) {
         return NULL;
     }
@@ -39,13 +41,14 @@ SafetyResult* safety_check_move(Grid* grid, const Snake* snake, Direction move,
     result->simulated_head_pos = (Position){-1, -1};
 
     /* Calculate where head would be after move */
-    Position current_head = snake->head->pos;
+    Position current_head = snake_head(snake);
     Position new_head = position_move(current_head, move);
     result->simulated_head_pos = new_head;
 
     /* Boundary check: is new position in bounds? */
-    if (!grid_is_valid_position(new_head)) {
+    if (!grid_is_valid_position(grid, new_head)) {
         result->is_safe = false;
+        timer_stop(&timer);
         result->compute_time_us = timer_elapsed_us(&timer);
         return result;
     }
@@ -54,6 +57,7 @@ SafetyResult* safety_check_move(Grid* grid, const Snake* snake, Direction move,
     if (!grid_is_walkable(grid, new_head)) {
         /* Can't move here - wall or body segment */
         result->is_safe = false;
+        timer_stop(&timer);
         result->compute_time_us = timer_elapsed_us(&timer);
         return result;
     }
@@ -74,6 +78,7 @@ SafetyResult* safety_check_move(Grid* grid, const Snake* snake, Direction move,
          * The moving tail ensures we don't trap ourselves
          */
         result->is_safe = true;  /* Already passed walkability check */
+        timer_stop(&timer);
         result->compute_time_us = timer_elapsed_us(&timer);
         return result;
     }
@@ -84,48 +89,137 @@ SafetyResult* safety_check_move(Grid* grid, const Snake* snake, Direction move,
      */
 
     /* Edge case: Win condition (filling grid) */
-    size_t grid_size = GRID_WIDTH * GRID_HEIGHT;
+    size_t grid_size = grid_cell_count(grid);
     if (snake->length + 1 >= grid_size) {
         result->is_safe = true;
+        timer_stop(&timer);
         result->compute_time_us = timer_elapsed_us(&timer);
         return result;
     }
 
     /* Save old head's cell type for restoration */
     Position old_head = current_head;
-    CellType old_head_type = grid->cells[old_head.y][old_head.x].type;
+    CellType old_head_type = grid_get_cell(grid, old_head);
 
     /* Simulate: Mark old head as body (represents growth) */
-    grid->cells[old_head.y][old_head.x].type = CELL_SNAKE_BODY;
+    grid_set_cell(grid, old_head, CELL_SNAKE_BODY);
 
     /* Check: Can we reach tail from new head after eating? */
-    Position tail_pos = snake->tail->pos;
-    result->escape_path = pathfinding_bfs(grid, new_head, tail_pos);
+    Position tail_pos = snake_tail(snake);
+    result->escape_path = pathfinding_astar(grid, workspace, new_head, tail_pos);
 
     /* Verdict: safe if escape path exists */
     result->is_safe = (result->escape_path != NULL && result->escape_path->found);
 
     /* Revert grid to original state */
-    grid->cells[old_head.y][old_head.x].type = old_head_type;
+    grid_set_cell(grid, old_head, old_head_type);
 
+    timer_stop(&timer);
     result->compute_time_us = timer_elapsed_us(&timer);
     return result;
 }
 
-/**
- * Clean up a SafetyResult and all its resources
- */
-void safety_result_destroy(SafetyResult* result) {
+/* One grid cell overwritten by the virtual snake */
+typedef struct {
+    Position pos;
+    CellType type;              /* Type before the change */
+} CellChange;
+
+/* Set a cell and log its previous type */
+static void virtual_set_cell(Grid* grid, CellChange* log, size_t* count, Position pos, CellType type) {
+    log[*count].pos = pos;
+    log[*count].type = grid_get_cell(grid, pos);
+    (*count)++;
+    grid_set_cell(grid, pos, type);
+}
+
+SafetyResult* safety_check_path(Grid* grid, SearchWorkspace* workspace, const Snake* snake,
+                                const PathResult* path) {
+    if (!grid || !workspace || !snake || !path || !path->found || path->length < 2) {
+        return NULL;
+    }
+
+    Timer timer;
+    timer_start(&timer);
+
+    SafetyResult* result = (SafetyResult*)memory_arena_alloc(&workspace->results,
+                                                            sizeof(SafetyResult));
     if (!result) {
-        return;
+        return NULL;
+    }
+
+    size_t moves = path->length - 1;
+    Position new_head = path->positions[moves];
+
+    result->escape_path = NULL;
+    result->is_safe = false;
+    result->will_eat_food = true;
+    result->simulated_head_pos = new_head;
+
+    /* Edge case: the meal fills the grid */
+    size_t new_length = snake->length + 1;
+    if (new_length >= grid_cell_count(grid)) {
+        result->is_safe = true;
+        timer_stop(&timer);
+        result->compute_time_us = timer_elapsed_us(&timer);
+        return result;
+    }
+
+    /* Every old segment and every path cell may change once */
+    CellChange* log = (CellChange*)memory_arena_alloc(&workspace->results,
+                                                      sizeof(CellChange) * (snake->length + moves + 1));
+    if (!log) {
+        return NULL;
+    }
+    size_t changes = 0;
+
+    /*
+     * After the path the body is the path reversed (head = food), then the
+     * first `kept` old segments: the snake grew by one on the last move, so
+     * it spans new_length cells.
+     */
+    size_t kept = (new_length > moves) ? new_length - moves : 0;
+
+    /*
+     * Make: vacate outrun segments, then lay the body along the path. Long
+     * snakes take a while, so the deadline is checked as cells change; a
+     * make cut off by it is unmade and the path counts as unsafe.
+     */
+    bool cut_off = false;
+    for (size_t i = kept; i < snake->length && !cut_off; i++) {
+        virtual_set_cell(grid, log, &changes, snake_get_segment(snake, i), CELL_EMPTY);
+        cut_off = search_workspace_out_of_time(workspace, changes);
+    }
+    for (size_t i = 0; i < kept && !cut_off; i++) {
+        virtual_set_cell(grid, log, &changes, snake_get_segment(snake, i), CELL_SNAKE_BODY);
+        cut_off = search_workspace_out_of_time(workspace, changes);
+    }
+
+    size_t first_path_cell = (moves > new_length) ? moves - new_length + 1 : 1;
+    for (size_t i = first_path_cell; i < moves && !cut_off; i++) {
+        virtual_set_cell(grid, log, &changes, path->positions[i], CELL_SNAKE_BODY);
+        cut_off = search_workspace_out_of_time(workspace, changes);
+    }
+
+    if (!cut_off) {
+        virtual_set_cell(grid, log, &changes, new_head, CELL_SNAKE_HEAD);
+
+        Position tail_pos = (kept > 0) ? snake_get_segment(snake, kept - 1)
+                                       : path->positions[first_path_cell];
+        virtual_set_cell(grid, log, &changes, tail_pos, CELL_SNAKE_TAIL);
+
+        /* Check: can the grown snake reach its tail? */
+        result->escape_path = pathfinding_astar(grid, workspace, new_head, tail_pos);
+        result->is_safe = (result->escape_path != NULL && result->escape_path->found);
     }
 
-    /* Clean up escape path if it exists */
-    if (result->escape_path) {
-        pathfinding_free_result(result->escape_path);
-        result->escape_path = NULL;
+    /* Unmake in reverse order */
+    while (changes > 0) {
+        changes--;
+        grid_set_cell(grid, log[changes].pos, log[changes].type);
     }
 
-    /* Free the result structure itself */
-    memory_tracked_free(result);
+    timer_stop(&timer);
+    result->compute_time_us = timer_elapsed_us(&timer);
+    return result;
 }
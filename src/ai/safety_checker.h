@@ -40,18 +40,36 @@ typedef struct {
  * an escape route exists if food is eaten.
  *
  * @param grid Current grid state (will not be modified permanently)
+ * @param workspace Scratch buffers for the escape path search
  * @param snake Current snake state
  * @param move Direction to move
  * @param food_pos Position of food
- * @return SafetyResult* Result of safety check (caller must free with safety_result_destroy)
+ * @return SafetyResult* Result of safety check, allocated from the workspace result arena
  */
-SafetyResult* safety_check_move(Grid* grid, const Snake* snake, Direction move, Position food_pos);
+SafetyResult* safety_check_move(Grid* grid, SearchWorkspace* workspace, const Snake* snake,
+                                Direction move, Position food_pos);
 
 /**
- * Clean up a SafetyResult and all its resources
+ * Check if following a whole path to food is safe (full-path mode)
  *
- * @param result SafetyResult to destroy (can be NULL)
+ * Where safety_check_move looks one step ahead, this places a virtual snake
+ * at the end of the path: the cells of the path become its new head and
+ * body, the segments it has outrun are vacated, and it has grown by one.
+ * The path is safe if an escape path leads from that head to that tail.
+ * The virtual snake is made on the grid from the snake's flat segment
+ * array and the change log is unmade afterwards, so nothing is copied.
+ * Making it and the escape search both stop at the workspace deadline; a
+ * check cut off that way reports the path unsafe (workspace->deadline_passed
+ * tells the two apart).
+ *
+ * @param grid Current grid state (will not be modified permanently)
+ * @param workspace Scratch buffers for the escape path search
+ * @param snake Current snake state
+ * @param path Path from the snake's head to the food (PathResult.found)
+ * @return SafetyResult* Result of the check (simulated_head_pos is the food),
+ *         allocated from the workspace result arena; NULL if path was not found
  */
-void safety_result_destroy(SafetyResult* result);
+SafetyResult* safety_check_path(Grid* grid, SearchWorkspace* workspace, const Snake* snake,
+                                const PathResult* path);
 
 #endif /* SAFETY_CHECKER_H */
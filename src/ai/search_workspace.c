@@ -0,0 +1,54 @@
+#include "search_workspace.h"
+#include <stdlib.h>
+
+/* Fixed-size result structs per decision, on top of one full-board path */
+#define RESULT_STRUCT_BYTES 4096
+
+SearchWorkspace* search_workspace_create(size_t cell_count) {
+    if (cell_count == 0) {
+        return NULL;
+    }
+
+    SearchWorkspace* workspace = (SearchWorkspace*)memory_tracked_malloc(sizeof(SearchWorkspace));
+    if (!workspace) {
+        return NULL;
+    }
+
+    workspace->cell_count = cell_count;
+    workspace->deadline_us = 0;
+    workspace->deadline_passed = false;
+    workspace->frontier = queue_create(cell_count + 1);
+    workspace->path = (Position*)memory_tracked_malloc(sizeof(Position) * cell_count);
+    workspace->heap = (SearchHeapNode*)memory_tracked_malloc(sizeof(SearchHeapNode) * cell_count);
+    workspace->heap_pos = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cell_count);
+    workspace->heap_size = 0;
+    workspace->runs = (RegionRun*)memory_tracked_malloc(sizeof(RegionRun) * cell_count);
+    workspace->row_runs = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * (cell_count + 1));
+
+    /* Typical decisions fit in the first block; longer paths chain another */
+    bool arena_ready = memory_arena_init(&workspace->results,
+                                         sizeof(Position) * cell_count + RESULT_STRUCT_BYTES);
+
+    if (!workspace->frontier || !workspace->path || !workspace->heap ||
+        !workspace->heap_pos || !workspace->runs || !workspace->row_runs || !arena_ready) {
+        search_workspace_destroy(workspace);
+        return NULL;
+    }
+
+    return workspace;
+}
+
+void search_workspace_destroy(SearchWorkspace* workspace) {
+    if (!workspace) {
+        return;
+    }
+
+    queue_destroy(workspace->frontier);
+    memory_tracked_free(workspace->path);
+    memory_tracked_free(workspace->heap);
+    memory_tracked_free(workspace->heap_pos);
+    memory_tracked_free(workspace->runs);
+    memory_tracked_free(workspace->row_runs);
+    memory_arena_destroy(&workspace->results);
+    memory_tracked_free(workspace);
+}
@@ -0,0 +1,105 @@
+#ifndef SEARCH_WORKSPACE_H
+#define SEARCH_WORKSPACE_H
+
+#include "../../include/common.h"
+#include "../data_structures/queue.h"
+#include "../utils/memory_tracker.h"
+#include "../utils/timer.h"
+
+/* A* open-set entry */
+typedef struct {
+    uint32_t cell;      /* Cell index */
+    uint32_t f_score;   /* Distance so far + heuristic */
+} SearchHeapNode;
+
+/* Expansions between two deadline checks (power of two) */
+#define SEARCH_DEADLINE_INTERVAL 256
+
+/* heap_pos value of a cell that has been expanded */
+#define SEARCH_HEAP_CLOSED UINT32_MAX
+
+/* Run of free cells in one row; a node of the region union-find forest */
+typedef struct {
+    int32_t x_begin;    /* First cell of the run */
+    int32_t x_end;      /* One past the last cell */
+    uint32_t parent;    /* Parent run (itself at a root) */
+    uint32_t size;      /* Cells in the region (valid at roots) */
+} RegionRun;
+
+/**
+ * Search Workspace Module
+ *
+ * Scratch buffers shared by every search of one AI controller: the BFS
+ * frontier queue, the A* open-set heap, a path buffer for reconstruction and
+ * the run forest of region labeling. Sized once for a board
+ * and reused by each call, so pathfinding, space analysis and safety checks
+ * do not allocate per search. Per-cell distance, parent and visited marks
+ * live in the Grid (generation-stamped, reset in O(1)).
+ *
+ * Search results (PathResult, SafetyResult, SpaceAnalysis, AIDecision) are
+ * bump-allocated from `results`, which the controller resets once per
+ * decision; results are never freed individually.
+ *
+ * With a deadline set, path searches read the clock every
+ * SEARCH_DEADLINE_INTERVAL expansions and give up once it has passed; the
+ * miss is sticky, so every later search of the decision gives up at once.
+ *
+ * A workspace must not be shared between threads; each game or worker owns one.
+ */
+typedef struct {
+    Queue* frontier;     /* BFS frontier (capacity: board cells + 1) */
+    Position* path;      /* Path reconstruction buffer (board cells entries) */
+    SearchHeapNode* heap;/* A* binary min-heap (board cells entries) */
+    uint32_t* heap_pos;  /* Heap slot of each open cell, SEARCH_HEAP_CLOSED once expanded */
+    size_t heap_size;    /* Entries in the heap */
+    RegionRun* runs;     /* Free-cell runs of region labeling (board cells entries) */
+    uint32_t* row_runs;  /* Index of each row's first run (board cells + 1 entries) */
+    MemoryArena results; /* Per-decision result storage */
+    uint64_t deadline_us;/* timer_now_us time searches give up at, 0 = no deadline */
+    bool deadline_passed;/* A search has seen the deadline pass */
+    size_t cell_count;   /* Board cells the workspace was sized for */
+} SearchWorkspace;
+
+/**
+ * Create a workspace for boards of up to cell_count cells
+ * @param cell_count Number of board cells
+ * @return Pointer to new workspace or NULL on failure
+ */
+SearchWorkspace* search_workspace_create(size_t cell_count);
+
+/**
+ * Destroy workspace and free its buffers
+ * @param workspace Workspace to destroy
+ */
+void search_workspace_destroy(SearchWorkspace* workspace);
+
+/**
+ * Set the time after which searches give up, and clear a previous miss
+ * @param workspace Workspace
+ * @param deadline_us timer_now_us time, 0 for no deadline
+ */
+static inline void search_workspace_set_deadline(SearchWorkspace* workspace, uint64_t deadline_us) {
+    workspace->deadline_us = deadline_us;
+    workspace->deadline_passed = false;
+}
+
+/**
+ * Deadline check for search loops
+ * Reads the clock only every SEARCH_DEADLINE_INTERVAL expansions.
+ * @param workspace Workspace
+ * @param expanded Nodes expanded so far by the calling search
+ * @return true if the search must give up
+ */
+static inline bool search_workspace_out_of_time(SearchWorkspace* workspace, size_t expanded) {
+    if (workspace->deadline_passed) {
+        return true;
+    }
+    if (workspace->deadline_us == 0 || (expanded & (SEARCH_DEADLINE_INTERVAL - 1)) != 0) {
+        return false;
+    }
+
+    workspace->deadline_passed = timer_now_us() >= workspace->deadline_us;
+    return workspace->deadline_passed;
+}
+
+#endif /* SEARCH_WORKSPACE_H */
@@ -3,57 +3,33 @@
 #include "../utils/timer.h"
 #include "../utils/memory_tracker.h"
 #include <stdlib.h>
-#include <string.h>
+#include <assert.h>
+
+/* Rows labeled between two deadline checks (power of two) */
+#define REGION_DEADLINE_ROWS 16
 
 /**
  * Count accessible cells from a position using BFS flood fill
  *
  * Algorithm:
- * 1. Create visited tracking array (20x20 grid)
+ * 1. Clear the grid's visited bitboard (one bit per cell)
  * 2. BFS from start position, counting all reachable walkable cells
  * 3. Return count of accessible cells
  *
- * This is used to evaluate move quality: moves that maximize accessible
- * space are preferred, as they keep more escape routes open.
+ * @return Number of accessible cells
  */
-SpaceAnalysis* space_analyze(Grid* grid, Position start) {
-    if (!grid) {
-        return NULL;
-    }
+static size_t space_count_bfs(Grid* grid, SearchWorkspace* workspace, Position start) {
+    /* Reset the grid's visited bits (one word per 64 cells) */
+    Bitboard* visited = &grid->visited;
+    bitboard_clear(visited);
 
-    Timer timer;
-    timer_start(&timer);
-
-    /* Allocate result */
-    SpaceAnalysis* result = (SpaceAnalysis*)memory_tracked_malloc(sizeof(SpaceAnalysis));
-    if (!result) {
-        return NULL;
-    }
-
-    result->accessible_cells = 0;
-    result->is_valid = false;
-    result->compute_time_us = 0;
-
-    /* Check if start position is valid and walkable */
-    if (!grid_is_valid_position(start) || !grid_is_walkable(grid, start)) {
-        result->compute_time_us = timer_elapsed_us(&timer);
-        return result;
-    }
-
-    /* Create visited array - use calloc for zero initialization */
-    bool visited[GRID_HEIGHT][GRID_WIDTH];
-    memset(visited, 0, sizeof(visited));
-
-    /* Create queue for BFS */
-    Queue* queue = queue_create(QUEUE_CAPACITY);
-    if (!queue) {
-        memory_tracked_free(result);
-        return NULL;
-    }
+    /* Reuse the workspace frontier (sized for the entire grid + 1) */
+    Queue* queue = workspace->frontier;
+    queue_clear(queue);
 
     /* Start BFS from start position */
     queue_enqueue(queue, start, 0);  /* Distance doesn't matter for space counting */
-    visited[start.y][start.x] = true;
+    bitboard_set(visited, start);
     size_t count = 1;  /* Start position counts */
 
     /* BFS flood fill */
@@ -71,12 +47,12 @@ SpaceAnalysis* space_analyze(Grid* grid, Position start) {
             Position neighbor = position_move(current, dirs[i]);
 
             /* Skip if out of bounds */
-            if (!grid_is_valid_position(neighbor)) {
+            if (!grid_is_valid_position(grid, neighbor)) {
                 continue;
             }
 
             /* Skip if already visited */
-            if (visited[neighbor.y][neighbor.x]) {
+            if (bitboard_test(visited, neighbor)) {
                 continue;
             }
 
@@ -86,16 +62,51 @@ SpaceAnalysis* space_analyze(Grid* grid, Position start) {
             }
 
             /* Mark visited and enqueue */
-            visited[neighbor.y][neighbor.x] = true;
+            bitboard_set(visited, neighbor);
             queue_enqueue(queue, neighbor, 0);  /* Distance doesn't matter */
             count++;
         }
     }
 
-    queue_destroy(queue);
+    return count;
+}
 
-    result->accessible_cells = count;
+/**
+ * Count accessible cells from a position
+ *
+ * This is used to evaluate move quality: moves that maximize accessible
+ * space are preferred, as they keep more escape routes open.
+ */
+SpaceAnalysis* space_analyze(Grid* grid, SearchWorkspace* workspace, Position start) {
+    if (!grid || !workspace) {
+        return NULL;
+    }
+
+    Timer timer;
+    timer_start(&timer);
+
+    /* Allocate result */
+    SpaceAnalysis* result = (SpaceAnalysis*)memory_arena_alloc(&workspace->results,
+                                                              sizeof(SpaceAnalysis));
+    if (!result) {
+        return NULL;
+    }
+
+    result->accessible_cells = 0;
+    result->is_valid = false;
+    result->compute_time_us = 0;
+
+    /* Check if start position is valid and walkable */
+    if (!grid_is_valid_position(grid, start) || !grid_is_walkable(grid, start)) {
+        timer_stop(&timer);
+        result->compute_time_us = timer_elapsed_us(&timer);
+        return result;
+    }
+
+    result->accessible_cells = space_count_bfs(grid, workspace, start);
     result->is_valid = true;
+
+    timer_stop(&timer);
     result->compute_time_us = timer_elapsed_us(&timer);
 
     return result;
@@ -116,8 +127,9 @@ SpaceAnalysis* space_analyze(Grid* grid, Position start) {
  * - Analyze accessible space from new head position
  * - Revert all grid changes
  */
-SpaceAnalysis* space_analyze_move(Grid* grid, const Snake* snake, Direction move, Position food_pos) {
-    if (!grid || !snake || move == DIR_NONE) {
+SpaceAnalysis* space_analyze_move(Grid* grid, SearchWorkspace* workspace, const Snake* snake,
+                                  Direction move, Position food_pos) {
+    if (!grid || !workspace || !snake || move == DIR_NONE) {
         return NULL;
     }
 
@@ -125,15 +137,17 @@ SpaceAnalysis* space_analyze_move(Grid* grid, const Snake* snake, Direction move
     timer_start(&timer);
 
     /* Calculate new head position */
-    Position current_head = snake->head->pos;
+    Position current_head = snake_head(snake);
     Position new_head = position_move(current_head, move);
 
     /* Check if move is valid */
-    if (!grid_is_valid_position(new_head)) {
-        SpaceAnalysis* result = (SpaceAnalysis*)memory_tracked_malloc(sizeof(SpaceAnalysis));
+    if (!grid_is_valid_position(grid, new_head)) {
+        SpaceAnalysis* result = (SpaceAnalysis*)memory_arena_alloc(&workspace->results,
+                                                              sizeof(SpaceAnalysis));
         if (result) {
             result->accessible_cells = 0;
             result->is_valid = false;
+            timer_stop(&timer);
             result->compute_time_us = timer_elapsed_us(&timer);
         }
         return result;
@@ -144,38 +158,237 @@ SpaceAnalysis* space_analyze_move(Grid* grid, const Snake* snake, Direction move
 
     /* Save original grid state for restoration */
     Position old_head = current_head;
-    CellType old_head_type = grid->cells[old_head.y][old_head.x].type;
+    CellType old_head_type = grid_get_cell(grid, old_head);
 
-    Position tail_pos = snake->tail->pos;
-    CellType old_tail_type = grid->cells[tail_pos.y][tail_pos.x].type;
+    Position tail_pos = snake_tail(snake);
+    CellType old_tail_type = grid_get_cell(grid, tail_pos);
 
     /* Simulate the move */
-    grid->cells[old_head.y][old_head.x].type = CELL_SNAKE_BODY;
+    grid_set_cell(grid, old_head, CELL_SNAKE_BODY);
 
     if (!will_eat_food) {
         /* Non-food move: tail moves forward, clear old tail position */
-        grid->cells[tail_pos.y][tail_pos.x].type = CELL_EMPTY;
+        grid_set_cell(grid, tail_pos, CELL_EMPTY);
     }
     /* If eating food: tail stays in place (snake grows) */
 
     /* Analyze accessible space from new head position */
-    SpaceAnalysis* result = space_analyze(grid, new_head);
+    SpaceAnalysis* result = space_analyze(grid, workspace, new_head);
 
     /* Revert grid to original state */
-    grid->cells[old_head.y][old_head.x].type = old_head_type;
-    grid->cells[tail_pos.y][tail_pos.x].type = old_tail_type;
+    grid_set_cell(grid, old_head, old_head_type);
+    grid_set_cell(grid, tail_pos, old_tail_type);
 
     /* Update timing to include full operation */
     if (result) {
+        timer_stop(&timer);
         result->compute_time_us = timer_elapsed_us(&timer);
     }
 
     return result;
 }
 
-void space_analysis_destroy(SpaceAnalysis* analysis) {
-    if (!analysis) {
+/* First x >= from in a row whose cell is free (`want_free`) or blocked, or width if none */
+static int region_row_scan(const uint64_t* blocked_row, int width, int from, bool want_free) {
+    if (from >= width) {
+        return width;
+    }
+
+    size_t w = (size_t)from / 64;
+    uint64_t word = (want_free ? ~blocked_row[w] : blocked_row[w]) & (~0ULL << (from % 64));
+    while (word == 0) {
+        w++;
+        if (w * 64 >= (size_t)width) {
+            return width;
+        }
+        word = want_free ? ~blocked_row[w] : blocked_row[w];
+    }
+
+    int x = (int)(w * 64) + __builtin_ctzll(word);
+    return x < width ? x : width;
+}
+
+/* Root run of a region, halving the path on the way */
+static uint32_t region_find(RegionRun* runs, uint32_t run) {
+    while (runs[run].parent != run) {
+        runs[run].parent = runs[runs[run].parent].parent;
+        run = runs[run].parent;
+    }
+    return run;
+}
+
+/* Merge two regions, attaching the smaller under the larger */
+static void region_union(RegionRun* runs, uint32_t a, uint32_t b) {
+    a = region_find(runs, a);
+    b = region_find(runs, b);
+    if (a == b) {
         return;
     }
-    memory_tracked_free(analysis);
+    if (runs[a].size < runs[b].size) {
+        uint32_t swap = a;
+        a = b;
+        b = swap;
+    }
+    runs[b].parent = a;
+    runs[a].size += runs[b].size;
+}
+
+/*
+ * Label the regions of free cells in a single row-by-row sweep: split each
+ * row into runs of free cells, then union every run with the runs of the
+ * previous row it overlaps (a two-pointer merge, both rows being sorted).
+ * Returns false if cut off at the workspace deadline, leaving the labels
+ * incomplete.
+ */
+static bool region_label(const Grid* grid, SearchWorkspace* workspace) {
+    RegionRun* runs = workspace->runs;
+    uint32_t* row_runs = workspace->row_runs;
+    size_t words = grid->blocked.words_per_row;
+    uint32_t run_count = 0;
+
+    for (int y = 0; y < grid->height; y++) {
+        /* Checking with 0 expansions reads the clock */
+        if ((y & (REGION_DEADLINE_ROWS - 1)) == 0 && search_workspace_out_of_time(workspace, 0)) {
+            return false;
+        }
+
+        const uint64_t* blocked_row = &grid->blocked.words[(size_t)y * words];
+        row_runs[y] = run_count;
+
+        int x = region_row_scan(blocked_row, grid->width, 0, true);
+        while (x < grid->width) {
+            int end = region_row_scan(blocked_row, grid->width, x, false);
+            runs[run_count] = (RegionRun){x, end, run_count, (uint32_t)(end - x)};
+            run_count++;
+            x = region_row_scan(blocked_row, grid->width, end, true);
+        }
+
+        if (y == 0) {
+            continue;
+        }
+
+        uint32_t above = row_runs[y - 1];
+        uint32_t current = row_runs[y];
+        while (above < row_runs[y] && current < run_count) {
+            if (runs[above].x_begin < runs[current].x_end &&
+                runs[current].x_begin < runs[above].x_end) {
+                region_union(runs, above, current);
+            }
+            if (runs[above].x_end < runs[current].x_end) {
+                above++;
+            } else {
+                current++;
+            }
+        }
+    }
+
+    row_runs[grid->height] = run_count;
+    return true;
+}
+
+/* Root run of the region holding a free cell */
+static uint32_t region_of(SearchWorkspace* workspace, Position pos) {
+    RegionRun* runs = workspace->runs;
+    uint32_t run = workspace->row_runs[pos.y];
+    while (runs[run].x_end <= pos.x) {
+        run++;
+    }
+    return region_find(runs, run);
+}
+
+void space_analyze_moves(Grid* grid, SearchWorkspace* workspace, const Snake* snake,
+                         Position food_pos, SpaceAnalysis* results[5]) {
+    if (!results) {
+        return;
+    }
+    for (int d = 0; d < 5; d++) {
+        results[d] = NULL;
+    }
+    if (!grid || !workspace || !snake) {
+        return;
+    }
+
+    Timer timer;
+    timer_start(&timer);
+
+    /* The old head stays blocked after every move, so the current board is labeled as is */
+    bool labeled = region_label(grid, workspace);
+
+    /*
+     * Tail cells are walkable already, so freeing the tail changes nothing,
+     * except for a one-cell snake: its tail is the blocked head, which a move
+     * that does not eat opens, joining the regions around it.
+     */
+    Position tail_pos = snake_tail(snake);
+    bool tail_opens = !grid_is_walkable(grid, tail_pos);
+    uint32_t tail_regions[4];
+    int tail_region_count = 0;
+    size_t tail_region_cells = 1;
+
+    for (int d = DIR_UP; labeled && tail_opens && d <= DIR_RIGHT; d++) {
+        Position neighbor = position_move(tail_pos, (Direction)d);
+        if (!grid_is_valid_position(grid, neighbor) || !grid_is_walkable(grid, neighbor)) {
+            continue;
+        }
+
+        uint32_t region = region_of(workspace, neighbor);
+        bool seen = false;
+        for (int i = 0; i < tail_region_count; i++) {
+            seen |= (tail_regions[i] == region);
+        }
+        if (!seen) {
+            tail_regions[tail_region_count++] = region;
+            tail_region_cells += workspace->runs[region].size;
+        }
+    }
+
+    Position head_pos = snake_head(snake);
+
+    for (int d = DIR_UP; d <= DIR_RIGHT; d++) {
+        SpaceAnalysis* result = (SpaceAnalysis*)memory_arena_alloc(&workspace->results,
+                                                                  sizeof(SpaceAnalysis));
+        if (!result) {
+            continue;
+        }
+
+        result->accessible_cells = 0;
+        result->is_valid = false;
+        results[d] = result;
+
+        Position new_head = position_move(head_pos, (Direction)d);
+        if (!labeled || !grid_is_valid_position(grid, new_head)) {
+            continue;
+        }
+
+        bool frees_tail = tail_opens && !position_equals(new_head, food_pos);
+
+        if (grid_is_walkable(grid, new_head)) {
+            uint32_t region = region_of(workspace, new_head);
+            result->accessible_cells = workspace->runs[region].size;
+            for (int i = 0; frees_tail && i < tail_region_count; i++) {
+                if (tail_regions[i] == region) {
+                    result->accessible_cells = tail_region_cells;
+                }
+            }
+            result->is_valid = true;
+        }
+    }
+
+    timer_stop(&timer);
+    for (int d = DIR_UP; d <= DIR_RIGHT; d++) {
+        if (results[d]) {
+            results[d]->compute_time_us = timer_elapsed_us(&timer);
+        }
+    }
+
+#ifdef OUROBOROS_DEBUG_CHECKS
+    /* Cross-check every direction against a flood fill of the simulated move */
+    for (int d = DIR_UP; labeled && d <= DIR_RIGHT; d++) {
+        SpaceAnalysis* reference = space_analyze_move(grid, workspace, snake, (Direction)d, food_pos);
+        if (reference && results[d]) {
+            assert(reference->is_valid == results[d]->is_valid);
+            assert(reference->accessible_cells == results[d]->accessible_cells);
+        }
+    }
+#endif
 }
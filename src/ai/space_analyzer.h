@@ -4,6 +4,7 @@
 #include "../../include/common.h"
 #include "../data_structures/grid.h"
 #include "../data_structures/snake.h"
+#include "search_workspace.h"
 
 /**
  * Space analysis result
@@ -18,14 +19,16 @@ typedef struct {
 /**
  * Analyze accessible space from a given position using flood fill
  *
- * Uses BFS to count all cells reachable from start position.
- * Critical for avoiding self-trapping: accessible space must exceed snake length.
+ * BFS over the grid counting all cells reachable from start position.
+ * Move rating uses space_analyze_moves instead; this single-start fill is
+ * the reference its results are checked against (OUROBOROS_DEBUG_CHECKS).
  *
- * @param grid Current grid state
+ * @param grid Current grid state (visited bitboard is used as scratch)
+ * @param workspace Scratch buffers (the frontier queue is used)
  * @param start Starting position for analysis
- * @return SpaceAnalysis result (must be freed with space_analysis_destroy)
+ * @return SpaceAnalysis result, allocated from the workspace result arena
  */
-SpaceAnalysis* space_analyze(Grid* grid, Position start);
+SpaceAnalysis* space_analyze(Grid* grid, SearchWorkspace* workspace, Position start);
 
 /**
  * Analyze accessible space after simulating a move
@@ -34,17 +37,33 @@ SpaceAnalysis* space_analyze(Grid* grid, Position start);
  * Used for evaluating move quality without modifying game state.
  *
  * @param grid Current grid state
+ * @param workspace Scratch buffers for the analysis
  * @param snake Current snake
  * @param move Direction to simulate
  * @param food_pos Current food position
- * @return SpaceAnalysis result (must be freed with space_analysis_destroy)
+ * @return SpaceAnalysis result, allocated from the workspace result arena
  */
-SpaceAnalysis* space_analyze_move(Grid* grid, const Snake* snake, Direction move, Position food_pos);
+SpaceAnalysis* space_analyze_move(Grid* grid, SearchWorkspace* workspace, const Snake* snake,
+                                  Direction move, Position food_pos);
 
 /**
- * Free space analysis result
- * @param analysis SpaceAnalysis to free
+ * Analyze accessible space after each of the four moves in one pass
+ *
+ * Labels the connected regions of free cells once (union-find over the
+ * runs of each row) and answers every move from the labels, instead of one
+ * flood fill per move. Results equal space_analyze_move for each direction.
+ * The labeling stops at the workspace deadline; every result of a labeling
+ * cut off that way is left invalid (is_valid false: the move is unrated).
+ *
+ * @param grid Current grid state (not modified)
+ * @param workspace Scratch buffers for the labeling
+ * @param snake Current snake
+ * @param food_pos Current food position
+ * @param results Output: one result per direction, indexed by Direction
+ *                (results[DIR_NONE] is set to NULL); entries are NULL if an
+ *                allocation failed
  */
-void space_analysis_destroy(SpaceAnalysis* analysis);
+void space_analyze_moves(Grid* grid, SearchWorkspace* workspace, const Snake* snake,
+                         Position food_pos, SpaceAnalysis* results[5]);
 
 #endif /* SPACE_ANALYZER_H */
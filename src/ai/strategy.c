@@ -0,0 +1,106 @@
+#include "strategy.h"
+#include "ai_controller.h"
+#include "hamiltonian.h"
+#include <string.h>
+
+/* Space maximization: the full decision pipeline of ai_space_decide */
+static const AIStrategyOps space_strategy = {
+    "space",
+    "space maximization with food path and safety checks",
+    NULL,
+    NULL,
+    ai_space_decide,
+    NULL,
+    NULL
+};
+
+static bool hamiltonian_init(AIController* controller, int width, int height) {
+    controller->strategy_state = hamiltonian_cycle_create(width, height);
+    return controller->strategy_state != NULL;
+}
+
+/* Cycle lookup while the snake lies on the tour; the space pipeline until then */
+static Direction hamiltonian_decide(AIController* controller, GameState* state,
+                                    AIDecision* decision, MoveEvaluations* evals) {
+    HamiltonianCycle* cycle = (HamiltonianCycle*)controller->strategy_state;
+
+    /*
+     * No searches: a tour lookup, plus an O(length) walk of the body while
+     * shortcuts are on offer. Plain tour steps cannot trap the snake;
+     * shortcuts are safe only as far as the tour-order check is right.
+     */
+    Direction dir = hamiltonian_choose_move(cycle, &state->grid, state->snake);
+    if (dir != DIR_NONE) {
+        decision->used_hamiltonian = true;
+        return dir;
+    }
+
+    return ai_space_decide(controller, state, decision, evals);
+}
+
+static void hamiltonian_destroy(AIController* controller) {
+    hamiltonian_cycle_destroy((HamiltonianCycle*)controller->strategy_state);
+    controller->strategy_state = NULL;
+}
+
+static const AIStrategyOps hamiltonian_strategy = {
+    "hamiltonian",
+    "Hamiltonian cycle with safe shortcuts (even cell count)",
+    hamiltonian_cycle_exists,
+    hamiltonian_init,
+    hamiltonian_decide,
+    NULL,
+    hamiltonian_destroy
+};
+
+/* Most accessible space only: a baseline for the strategies above */
+static Direction fallback_decide(AIController* controller, GameState* state,
+                                 AIDecision* decision, MoveEvaluations* evals) {
+    decision->used_fallback = true;
+    return ai_fallback_strategy(controller, state, evals);
+}
+
+static const AIStrategyOps fallback_strategy = {
+    "fallback",
+    "most accessible space, no food seeking (baseline)",
+    NULL,
+    NULL,
+    fallback_decide,
+    NULL,
+    NULL
+};
+
+/* Registry, default first */
+static const AIStrategyOps* const strategies[] = {
+    &space_strategy,
+    &hamiltonian_strategy,
+    &fallback_strategy
+};
+
+#define STRATEGY_COUNT (sizeof(strategies) / sizeof(strategies[0]))
+
+const AIStrategyOps* ai_strategy_find(const char* name) {
+    if (!name) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < STRATEGY_COUNT; i++) {
+        if (strcmp(strategies[i]->name, name) == 0) {
+            return strategies[i];
+        }
+    }
+
+    return NULL;
+}
+
+size_t ai_strategy_count(void) {
+    return STRATEGY_COUNT;
+}
+
+const AIStrategyOps* ai_strategy_at(size_t index) {
+    return index < STRATEGY_COUNT ? strategies[index] : NULL;
+}
+
+const AIStrategyOps* ai_strategy_default(void) {
+    return strategies[0];
+}
@@ -0,0 +1,75 @@
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include "../../include/common.h"
+#include "../game/game_state.h"
+
+struct AIController;
+struct AIDecision;
+struct MoveEvaluations;
+
+/**
+ * Strategy Module
+ *
+ * A decision policy plugs into the AI controller as a table of functions.
+ * ai_make_decision keeps the per-tick bookkeeping (result arena, timing,
+ * shared move evaluations, display safety check) and asks the controller's
+ * strategy for the move. Strategies are registered by name and selected at
+ * runtime (--strategy NAME), so policies can be compared head to head on
+ * the same seeds without touching the controller. The games diverge from
+ * the first move two policies choose differently, so compare averages over
+ * many games rather than seed by seed.
+ *
+ * Built-in strategies:
+ * - space:       space maximization with safety checks, fallback when stuck
+ * - hamiltonian: Hamiltonian cycle with safe shortcuts, space until on it
+ * - fallback:    most accessible space only (no food path, no safety checks)
+ */
+typedef struct AIStrategyOps {
+    const char* name;           /* Selection name (--strategy) */
+    const char* description;    /* One line for the usage text */
+
+    /* Optional: can the strategy play a board of this size? (NULL: any) */
+    bool (*supports_board)(int width, int height);
+
+    /* Optional: build controller->strategy_state; false on failure */
+    bool (*init)(struct AIController* controller, int width, int height);
+
+    /* Choose a move; may fill the decision's path, space and strategy flags */
+    Direction (*decide)(struct AIController* controller, GameState* state,
+                        struct AIDecision* decision, struct MoveEvaluations* evals);
+
+    /* Optional: called once the chosen move has been applied */
+    void (*on_move)(struct AIController* controller, const GameState* state, Direction move);
+
+    /* Optional: release controller->strategy_state */
+    void (*destroy)(struct AIController* controller);
+} AIStrategyOps;
+
+/**
+ * Look up a registered strategy
+ * @param name Strategy name
+ * @return Strategy or NULL if none has that name
+ */
+const AIStrategyOps* ai_strategy_find(const char* name);
+
+/**
+ * Get the number of registered strategies
+ * @return Strategy count
+ */
+size_t ai_strategy_count(void);
+
+/**
+ * Get a registered strategy by position
+ * @param index Registry position (must be < ai_strategy_count)
+ * @return Strategy
+ */
+const AIStrategyOps* ai_strategy_at(size_t index);
+
+/**
+ * Get the default strategy (space)
+ * @return Strategy
+ */
+const AIStrategyOps* ai_strategy_default(void);
+
+#endif /* STRATEGY_H */
@@ -0,0 +1,47 @@
+#include "bitboard.h"
+#include "../utils/memory_tracker.h"
+#include <string.h>
+
+ResultCode bitboard_init(Bitboard* board, int width, int height) {
+    if (!board) {
+        return ERROR_NULL_POINTER;
+    }
+
+    board->width = width;
+    board->height = height;
+    board->words_per_row = ((size_t)width + 63) / 64;
+    board->word_count = board->words_per_row * (size_t)height;
+    board->words = (uint64_t*)memory_tracked_calloc(board->word_count, sizeof(uint64_t));
+
+    return board->words ? SUCCESS : ERROR_OUT_OF_MEMORY;
+}
+
+void bitboard_destroy(Bitboard* board) {
+    if (!board) {
+        return;
+    }
+
+    memory_tracked_free(board->words);
+    board->words = NULL;
+}
+
+void bitboard_clear(Bitboard* board) {
+    if (!board || !board->words) {
+        return;
+    }
+
+    memset(board->words, 0, board->word_count * sizeof(uint64_t));
+}
+
+size_t bitboard_count(const Bitboard* board) {
+    if (!board || !board->words) {
+        return 0;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < board->word_count; i++) {
+        count += (size_t)__builtin_popcountll(board->words[i]);
+    }
+
+    return count;
+}
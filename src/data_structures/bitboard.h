@@ -0,0 +1,101 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "../../include/common.h"
+
+/**
+ * Packed bitset over the board, one bit per cell
+ *
+ * Each row starts on a fresh 64-bit word (bit x of row y is bit x % 64 of
+ * word y * words_per_row + x / 64), so whole rows can be shifted and masked
+ * word by word. A 20x20 board takes 20 words, 160 bytes.
+ */
+typedef struct {
+    uint64_t* words;
+    int width;
+    int height;
+    size_t words_per_row;
+    size_t word_count;
+} Bitboard;
+
+/**
+ * Allocate a cleared bitboard
+ * @param board Bitboard to initialize
+ * @param width Board width in cells
+ * @param height Board height in cells
+ * @return SUCCESS or ERROR_OUT_OF_MEMORY
+ */
+ResultCode bitboard_init(Bitboard* board, int width, int height);
+
+/**
+ * Free bitboard storage
+ * @param board Bitboard to destroy (the struct itself is not freed)
+ */
+void bitboard_destroy(Bitboard* board);
+
+/**
+ * Clear every bit
+ * @param board Bitboard to clear
+ */
+void bitboard_clear(Bitboard* board);
+
+/**
+ * Count set bits
+ * @param board Bitboard to count
+ * @return Number of set bits
+ */
+size_t bitboard_count(const Bitboard* board);
+
+/* Word holding the bit of an in-bounds position */
+static inline size_t bitboard_word_index(const Bitboard* board, Position pos) {
+    return (size_t)pos.y * board->words_per_row + (size_t)pos.x / 64;
+}
+
+/* Mask of the bit of an in-bounds position within its word */
+static inline uint64_t bitboard_bit_mask(Position pos) {
+    return 1ULL << ((unsigned int)pos.x % 64);
+}
+
+/**
+ * Test the bit of an in-bounds position
+ * @param board Bitboard to query
+ * @param pos Position (must be valid)
+ * @return true if set
+ */
+static inline bool bitboard_test(const Bitboard* board, Position pos) {
+    return (board->words[bitboard_word_index(board, pos)] & bitboard_bit_mask(pos)) != 0;
+}
+
+/**
+ * Set the bit of an in-bounds position
+ * @param board Bitboard to modify
+ * @param pos Position (must be valid)
+ */
+static inline void bitboard_set(Bitboard* board, Position pos) {
+    board->words[bitboard_word_index(board, pos)] |= bitboard_bit_mask(pos);
+}
+
+/**
+ * Clear the bit of an in-bounds position
+ * @param board Bitboard to modify
+ * @param pos Position (must be valid)
+ */
+static inline void bitboard_reset(Bitboard* board, Position pos) {
+    board->words[bitboard_word_index(board, pos)] &= ~bitboard_bit_mask(pos);
+}
+
+/**
+ * Set or clear the bit of an in-bounds position
+ * @param board Bitboard to modify
+ * @param pos Position (must be valid)
+ * @param value New bit value
+ */
+static inline void bitboard_assign(Bitboard* board, Position pos, bool value) {
+    if (value) {
+        bitboard_set(board, pos);
+    } else {
+        bitboard_reset(board, pos);
+    }
+}
+
+#endif /* BITBOARD_H */
@@ -1,23 +1,59 @@
 #include "grid.h"
+#include "../utils/memory_tracker.h"
 #include <string.h>
 
-void grid_init(Grid* grid) {
+ResultCode grid_init(Grid* grid, int width, int height) {
     if (!grid) {
-        return;
+        return ERROR_NULL_POINTER;
     }
 
-    memset(grid->cells, 0, sizeof(grid->cells));
+    if (width < MIN_GRID_DIMENSION || width > MAX_GRID_DIMENSION ||
+        height < MIN_GRID_DIMENSION || height > MAX_GRID_DIMENSION) {
+        return ERROR_INVALID_POSITION;
+    }
 
-    for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            grid->cells[y][x].type = CELL_EMPTY;
-            grid->cells[y][x].distance = -1;
-            grid->cells[y][x].parent = (Position){-1, -1};
-            grid->cells[y][x].visited = false;
-        }
+    grid->width = width;
+    grid->height = height;
+    grid->blocked.words = NULL;
+    grid->visited.words = NULL;
+
+    size_t cell_count = grid_cell_count(grid);
+    grid->types = (uint8_t*)memory_tracked_calloc(cell_count, sizeof(uint8_t));
+    grid->distance = (int32_t*)memory_tracked_malloc(sizeof(int32_t) * cell_count);
+    grid->parent = (int32_t*)memory_tracked_malloc(sizeof(int32_t) * cell_count);
+    grid->visit_stamp = (uint32_t*)memory_tracked_calloc(cell_count, sizeof(uint32_t));
+    grid->search_generation = 1;  /* Stamps start at 0: nothing visited */
+
+    if (!grid->types || !grid->distance || !grid->parent || !grid->visit_stamp ||
+        bitboard_init(&grid->blocked, width, height) != SUCCESS ||
+        bitboard_init(&grid->visited, width, height) != SUCCESS) {
+        grid_destroy(grid);
+        return ERROR_OUT_OF_MEMORY;
     }
 
+    /* calloc leaves every cell CELL_EMPTY (0) */
     grid->food_pos = (Position){-1, -1};
+    grid->hash = 0;
+
+    return SUCCESS;
+}
+
+void grid_destroy(Grid* grid) {
+    if (!grid) {
+        return;
+    }
+
+    memory_tracked_free(grid->types);
+    memory_tracked_free(grid->distance);
+    memory_tracked_free(grid->parent);
+    memory_tracked_free(grid->visit_stamp);
+    grid->types = NULL;
+    grid->distance = NULL;
+    grid->parent = NULL;
+    grid->visit_stamp = NULL;
+
+    bitboard_destroy(&grid->blocked);
+    bitboard_destroy(&grid->visited);
 }
 
 void grid_reset_pathfinding(Grid* grid) {
@@ -25,47 +61,51 @@ void grid_reset_pathfinding(Grid* grid) {
         return;
     }
 
-    for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            grid->cells[y][x].distance = -1;
-            grid->cells[y][x].parent = (Position){-1, -1};
-            grid->cells[y][x].visited = false;
-        }
+    grid->search_generation++;
+
+    /* On wrap-around, old stamps could alias the new generation */
+    if (grid->search_generation == 0) {
+        memset(grid->visit_stamp, 0, sizeof(uint32_t) * grid_cell_count(grid));
+        grid->search_generation = 1;
     }
 }
 
 CellType grid_get_cell(const Grid* grid, Position pos) {
-    if (!grid || !grid_is_valid_position(pos)) {
+    if (!grid || !grid_is_valid_position(grid, pos)) {
         return CELL_WALL;  /* Out of bounds = wall */
     }
 
-    return grid->cells[pos.y][pos.x].type;
+    return (CellType)grid->types[grid_index(grid, pos)];
 }
 
 void grid_set_cell(Grid* grid, Position pos, CellType type) {
-    if (!grid || !grid_is_valid_position(pos)) {
+    if (!grid || !grid_is_valid_position(grid, pos)) {
         return;
     }
 
-    grid->cells[pos.y][pos.x].type = type;
+    size_t index = grid_index(grid, pos);
+    grid->hash ^= grid_zobrist_key(index, (CellType)grid->types[index]) ^
+                  grid_zobrist_key(index, type);
+    grid->types[index] = (uint8_t)type;
+    bitboard_assign(&grid->blocked, pos, grid_cell_type_blocks(type));
 }
 
-bool grid_is_valid_position(Position pos) {
-    return pos.x >= 0 && pos.x < GRID_WIDTH &&
-           pos.y >= 0 && pos.y < GRID_HEIGHT;
+bool grid_is_valid_position(const Grid* grid, Position pos) {
+    return pos.x >= 0 && pos.x < grid->width &&
+           pos.y >= 0 && pos.y < grid->height;
 }
 
 bool grid_is_walkable(const Grid* grid, Position pos) {
-    if (!grid || !grid_is_valid_position(pos)) {
+    if (!grid || !grid_is_valid_position(grid, pos)) {
         return false;
     }
 
-    CellType type = grid->cells[pos.y][pos.x].type;
-    return type == CELL_EMPTY || type == CELL_FOOD || type == CELL_SNAKE_TAIL;
+    /* Empty, food and tail cells are walkable */
+    return !bitboard_test(&grid->blocked, pos);
 }
 
-void grid_get_neighbors(Position pos, Position neighbors[4], int* count) {
-    if (!neighbors || !count) {
+void grid_get_neighbors(const Grid* grid, Position pos, Position neighbors[4], int* count) {
+    if (!grid || !neighbors || !count) {
         return;
     }
 
@@ -76,21 +116,51 @@ void grid_get_neighbors(Position pos, Position neighbors[4], int* count) {
 
     for (int i = 0; i < 4; i++) {
         Position next = position_move(pos, directions[i]);
-        if (grid_is_valid_position(next)) {
+        if (grid_is_valid_position(grid, next)) {
             neighbors[*count] = next;
             (*count)++;
         }
     }
 }
 
+ResultCode grid_copy(Grid* dst, const Grid* src) {
+    if (!dst || !src) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (dst->width != src->width || dst->height != src->height) {
+        return ERROR_INVALID_POSITION;
+    }
+
+    memcpy(dst->types, src->types, sizeof(uint8_t) * grid_cell_count(src));
+    memcpy(dst->blocked.words, src->blocked.words, sizeof(uint64_t) * src->blocked.word_count);
+    dst->hash = src->hash;
+    dst->food_pos = src->food_pos;
+
+    return SUCCESS;
+}
+
 void grid_clear(Grid* grid) {
     if (!grid) {
         return;
     }
 
-    for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            grid->cells[y][x].type = CELL_EMPTY;
-        }
+    memset(grid->types, CELL_EMPTY, grid_cell_count(grid));
+
+    bitboard_clear(&grid->blocked);
+    grid->hash = 0;
+}
+
+uint64_t grid_compute_hash(const Grid* grid) {
+    if (!grid) {
+        return 0;
     }
+
+    uint64_t hash = 0;
+    size_t cell_count = grid_cell_count(grid);
+    for (size_t i = 0; i < cell_count; i++) {
+        hash ^= grid_zobrist_key(i, (CellType)grid->types[i]);
+    }
+
+    return hash;
 }
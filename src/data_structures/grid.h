@@ -2,33 +2,110 @@
 #define GRID_H
 
 #include "../../include/common.h"
-
-/**
- * Grid cell structure for BFS pathfinding
- */
-typedef struct {
-    CellType type;       /* Current cell type (empty, snake, food, etc.) */
-    int distance;        /* Distance from start (for BFS) */
-    Position parent;     /* Parent position (for path reconstruction) */
-    bool visited;        /* Visited flag (for BFS) */
-} GridCell;
+#include "bitboard.h"
+#include "../utils/rng.h"
 
 /**
  * Grid structure representing the game board
+ *
+ * Struct-of-arrays layout, all arrays row-major and heap-allocated so the
+ * board size can be chosen at runtime:
+ * - `types` holds one byte per cell, so hot walkability scans stay dense
+ * - `distance`, `parent` and `visit_stamp` are BFS scratch; a cell counts as
+ *   visited only when its stamp equals `search_generation`, so starting a new
+ *   search is a counter bump instead of a pass over every cell
+ *
+ * `blocked` mirrors the cell types one bit per cell (head, body and wall
+ * cells are blocked) and `hash` is a Zobrist hash of all non-empty cells;
+ * both are kept in sync by grid_set_cell/grid_clear, so all cell type
+ * writes must go through those functions. `visited` is
+ * scratch space for flood fills.
  */
 typedef struct {
-    GridCell cells[GRID_HEIGHT][GRID_WIDTH];
+    uint8_t* types;              /* CellType of each cell */
+    int32_t* distance;           /* BFS distance from start (valid when visited) */
+    int32_t* parent;             /* BFS parent cell index, -1 for the start */
+    uint32_t* visit_stamp;       /* Generation in which the cell was last visited */
+    uint32_t search_generation;  /* Current BFS generation */
+    Bitboard blocked;            /* Set for cells that are not walkable */
+    Bitboard visited;            /* Flood fill scratch bits */
+    uint64_t hash;               /* Zobrist hash of the cell types (0 when empty) */
+    int width;
+    int height;
     Position food_pos;
 } Grid;
 
 /**
  * Initialize grid with empty cells
+ * Allocates cell storage; release it with grid_destroy
  * @param grid Grid to initialize
+ * @param width Board width in cells
+ * @param height Board height in cells
+ * @return SUCCESS, ERROR_INVALID_POSITION for bad dimensions, or ERROR_OUT_OF_MEMORY
+ */
+ResultCode grid_init(Grid* grid, int width, int height);
+
+/**
+ * Free cell storage allocated by grid_init
+ * @param grid Grid to destroy (the Grid struct itself is not freed)
+ */
+void grid_destroy(Grid* grid);
+
+/**
+ * Get number of cells on the board
+ * @param grid Grid to query
+ * @return width * height
+ */
+static inline size_t grid_cell_count(const Grid* grid) {
+    return (size_t)grid->width * (size_t)grid->height;
+}
+
+/**
+ * Get row-major index of an in-bounds position
+ * @param grid Grid to index
+ * @param pos Position (must be valid)
+ * @return Index into the grid's per-cell arrays
+ */
+static inline size_t grid_index(const Grid* grid, Position pos) {
+    return (size_t)pos.y * (size_t)grid->width + (size_t)pos.x;
+}
+
+/**
+ * Get position of a cell index
+ * @param grid Grid to index
+ * @param index Cell index (must be < grid_cell_count)
+ * @return Position of the cell
+ */
+static inline Position grid_position_of(const Grid* grid, size_t index) {
+    return (Position){(int)(index % (size_t)grid->width), (int)(index / (size_t)grid->width)};
+}
+
+/**
+ * Check if a cell was visited by the current search
+ * @param grid Grid to query
+ * @param index Cell index
+ * @return true if visited since the last grid_reset_pathfinding
  */
-void grid_init(Grid* grid);
+static inline bool grid_is_visited(const Grid* grid, size_t index) {
+    return grid->visit_stamp[index] == grid->search_generation;
+}
 
 /**
- * Reset pathfinding-related fields (visited, distance, parent)
+ * Mark a cell visited by the current search
+ * @param grid Grid to modify
+ * @param index Cell index
+ * @param distance Distance from the search start
+ * @param parent Parent cell index (-1 for the start)
+ */
+static inline void grid_mark_visited(Grid* grid, size_t index, int32_t distance, int32_t parent) {
+    grid->visit_stamp[index] = grid->search_generation;
+    grid->distance[index] = distance;
+    grid->parent[index] = parent;
+}
+
+/**
+ * Start a new search: every cell becomes unvisited
+ * O(1) generation bump (the stamps are only rewritten when the counter wraps)
  * Call before each BFS operation
  * @param grid Grid to reset
  */
@@ -52,10 +129,20 @@ void grid_set_cell(Grid* grid, Position pos, CellType type);
 
 /**
  * Check if position is within grid bounds
+ * @param grid Grid to check against
  * @param pos Position to check
  * @return true if valid, false otherwise
  */
-bool grid_is_valid_position(Position pos);
+bool grid_is_valid_position(const Grid* grid, Position pos);
+
+/**
+ * Check if a cell type blocks movement
+ * @param type Cell type
+ * @return true for head, body and wall cells
+ */
+static inline bool grid_cell_type_blocks(CellType type) {
+    return type == CELL_SNAKE_HEAD || type == CELL_SNAKE_BODY || type == CELL_WALL;
+}
 
 /**
  * Check if position is walkable (for pathfinding)
@@ -67,11 +154,55 @@ bool grid_is_walkable(const Grid* grid, Position pos);
 
 /**
  * Get all valid neighbors of a position
+ * @param grid Grid to check bounds against
  * @param pos Position to get neighbors for
  * @param neighbors Output array for neighbors (size 4)
  * @param count Output parameter for number of valid neighbors
  */
-void grid_get_neighbors(Position pos, Position neighbors[4], int* count);
+void grid_get_neighbors(const Grid* grid, Position pos, Position neighbors[4], int* count);
+
+/**
+ * Get the Zobrist key of a cell holding a type
+ * Keys are derived from (cell, type) with SplitMix64, so they need no table
+ * and are the same for every grid and run. Empty cells have key 0.
+ * @param cell Cell index
+ * @param type Cell type
+ * @return 64-bit key
+ */
+static inline uint64_t grid_zobrist_key(size_t cell, CellType type) {
+    if (type == CELL_EMPTY) {
+        return 0;
+    }
+    return rng_splitmix64((uint64_t)cell * (CELL_WALL + 1) + (uint64_t)type);
+}
+
+/**
+ * Get the Zobrist hash of the board
+ * Updated in O(1) by every grid_set_cell, so simulated moves that are
+ * reverted also restore the hash.
+ * @param grid Grid to query
+ * @return 64-bit hash of the cell types
+ */
+static inline uint64_t grid_hash(const Grid* grid) {
+    return grid->hash;
+}
+
+/**
+ * Recompute the Zobrist hash from scratch (O(cells))
+ * Reference for the incrementally maintained grid_hash.
+ * @param grid Grid to hash
+ * @return 64-bit hash of the cell types
+ */
+uint64_t grid_compute_hash(const Grid* grid);
+
+/**
+ * Copy the cells, food and hash of a grid into another of the same size
+ * Search scratch (distance, parent, visit stamps, visited bits) is not copied.
+ * @param dst Grid to overwrite
+ * @param src Grid to copy
+ * @return SUCCESS, ERROR_NULL_POINTER, or ERROR_INVALID_POSITION if the sizes differ
+ */
+ResultCode grid_copy(Grid* dst, const Grid* src);
 
 /**
  * Clear entire grid to empty cells
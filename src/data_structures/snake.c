@@ -1,65 +1,118 @@
 #include "snake.h"
 #include "../utils/memory_tracker.h"
 #include <stdlib.h>
+#include <string.h>
 
-/* Helper function to create a new segment */
-static SnakeSegment* segment_create(Position pos) {
-    SnakeSegment* segment = (SnakeSegment*)memory_tracked_malloc(sizeof(SnakeSegment));
-    if (!segment) {
-        return NULL;
+/* Index of a position in the occupancy arrays, or -1 if off the board */
+static long snake_cell_index(const Snake* snake, Position pos) {
+    if (pos.x < 0 || pos.x >= snake->grid_width ||
+        pos.y < 0 || pos.y >= snake->grid_height) {
+        return -1;
     }
 
-    segment->pos = pos;
-    segment->next = NULL;
-    segment->prev = NULL;
+    return (long)pos.y * snake->grid_width + pos.x;
+}
+
+/* Remove a cell from the free set (swap the last free cell into its slot) */
+static void snake_free_set_remove(Snake* snake, long cell) {
+    uint32_t slot = snake->free_slot[cell];
+    uint32_t last = snake->free_cells[--snake->free_count];
+
+    snake->free_cells[slot] = last;
+    snake->free_slot[last] = slot;
+}
 
-    return segment;
+/* Add a cell to the end of the free set */
+static void snake_free_set_add(Snake* snake, long cell) {
+    snake->free_slot[cell] = (uint32_t)snake->free_count;
+    snake->free_cells[snake->free_count++] = (uint32_t)cell;
 }
 
-Snake* snake_create(Position initial_pos, Direction initial_dir) {
+/* Record that ring slot `slot` now covers `pos` */
+static void snake_occupy(Snake* snake, Position pos, size_t slot) {
+    long cell = snake_cell_index(snake, pos);
+    if (cell < 0) {
+        return;  /* Head left the board: game over, nothing to index */
+    }
+
+    if (snake->cell_count[cell] == 0) {
+        snake_free_set_remove(snake, cell);
+    }
+
+    snake->cell_count[cell]++;
+    snake->cell_slot[cell] = (uint32_t)slot;
+}
+
+/* Record that the segment on `pos` has left it */
+static void snake_vacate(Snake* snake, Position pos) {
+    long cell = snake_cell_index(snake, pos);
+    if (cell < 0 || snake->cell_count[cell] == 0) {
+        return;
+    }
+
+    snake->cell_count[cell]--;
+
+    if (snake->cell_count[cell] == 0) {
+        snake_free_set_add(snake, cell);
+        return;
+    }
+
+    /* A remaining segment here can only be the head that collided into it */
+    snake->cell_slot[cell] = (uint32_t)snake->head_index;
+}
+
+Snake* snake_create(Position initial_pos, Direction initial_dir, int grid_width, int grid_height) {
+    if (grid_width <= 0 || grid_height <= 0) {
+        return NULL;
+    }
+
     Snake* snake = (Snake*)memory_tracked_malloc(sizeof(Snake));
     if (!snake) {
         return NULL;
     }
 
+    size_t cell_count = (size_t)grid_width * (size_t)grid_height;
+
+    snake->grid_width = grid_width;
+    snake->grid_height = grid_height;
+    snake->capacity = cell_count + 1;
+    snake->head_index = 0;
+    snake->body = (Position*)memory_tracked_malloc(sizeof(Position) * snake->capacity);
+    snake->cell_count = (uint8_t*)memory_tracked_calloc(cell_count, sizeof(uint8_t));
+    snake->cell_slot = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cell_count);
+    snake->free_cells = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cell_count);
+    snake->free_slot = (uint32_t*)memory_tracked_malloc(sizeof(uint32_t) * cell_count);
+
+    if (!snake->body || !snake->cell_count || !snake->cell_slot ||
+        !snake->free_cells || !snake->free_slot) {
+        snake_destroy(snake);
+        return NULL;
+    }
+
+    /* Every cell starts free */
+    snake->free_count = 0;
+    for (size_t cell = 0; cell < cell_count; cell++) {
+        snake_free_set_add(snake, (long)cell);
+    }
+
     snake->current_direction = initial_dir;
     snake->next_direction = initial_dir;
     snake->length = INITIAL_SNAKE_LENGTH;
     snake->score = 0;
 
-    /* Create initial segments */
+    /* Create initial segments (growing backwards from head) */
     Position offset = direction_to_offset(initial_dir);
 
-    /* Create head */
-    snake->head = segment_create(initial_pos);
-    if (!snake->head) {
-        memory_tracked_free(snake);
-        return NULL;
-    }
-
-    SnakeSegment* current = snake->head;
-
-    /* Create body segments (growing backwards from head) */
-    for (size_t i = 1; i < INITIAL_SNAKE_LENGTH; i++) {
+    for (size_t i = 0; i < INITIAL_SNAKE_LENGTH; i++) {
         Position seg_pos = {
             initial_pos.x - (offset.x * (int)i),
             initial_pos.y - (offset.y * (int)i)
         };
 
-        SnakeSegment* new_segment = segment_create(seg_pos);
-        if (!new_segment) {
-            snake_destroy(snake);
-            return NULL;
-        }
-
-        /* Link segments */
-        current->next = new_segment;
-        new_segment->prev = current;
-        current = new_segment;
+        snake->body[i] = seg_pos;
+        snake_occupy(snake, seg_pos, i);
     }
 
-    snake->tail = current;
-
     return snake;
 }
 
@@ -68,15 +121,38 @@ void snake_destroy(Snake* snake) {
         return;
     }
 
-    /* Free all segments */
-    SnakeSegment* current = snake->head;
-    while (current) {
-        SnakeSegment* next = current->next;
-        memory_tracked_free(current);
-        current = next;
+    memory_tracked_free(snake->body);
+    memory_tracked_free(snake->cell_count);
+    memory_tracked_free(snake->cell_slot);
+    memory_tracked_free(snake->free_cells);
+    memory_tracked_free(snake->free_slot);
+    memory_tracked_free(snake);
+}
+
+ResultCode snake_copy(Snake* dst, const Snake* src) {
+    if (!dst || !src) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if (dst->grid_width != src->grid_width || dst->grid_height != src->grid_height) {
+        return ERROR_INVALID_POSITION;
     }
 
-    memory_tracked_free(snake);
+    size_t cell_count = (size_t)src->grid_width * (size_t)src->grid_height;
+    memcpy(dst->body, src->body, sizeof(Position) * src->capacity);
+    memcpy(dst->cell_count, src->cell_count, sizeof(uint8_t) * cell_count);
+    memcpy(dst->cell_slot, src->cell_slot, sizeof(uint32_t) * cell_count);
+    memcpy(dst->free_cells, src->free_cells, sizeof(uint32_t) * cell_count);
+    memcpy(dst->free_slot, src->free_slot, sizeof(uint32_t) * cell_count);
+
+    dst->head_index = src->head_index;
+    dst->free_count = src->free_count;
+    dst->current_direction = src->current_direction;
+    dst->next_direction = src->next_direction;
+    dst->length = src->length;
+    dst->score = src->score;
+
+    return SUCCESS;
 }
 
 ResultCode snake_move(Snake* snake, bool grow) {
@@ -84,35 +160,29 @@ ResultCode snake_move(Snake* snake, bool grow) {
         return ERROR_NULL_POINTER;
     }
 
+    if (grow && snake->length + 1 >= snake->capacity) {
+        return ERROR_OUT_OF_MEMORY;
+    }
+
     /* Update current direction from next direction */
     snake->current_direction = snake->next_direction;
 
     /* Calculate new head position */
     Position new_head_pos = snake_get_next_head_position(snake);
 
-    /* Create new head segment */
-    SnakeSegment* new_head = segment_create(new_head_pos);
-    if (!new_head) {
-        return ERROR_OUT_OF_MEMORY;
-    }
-
-    /* Link new head to old head */
-    new_head->next = snake->head;
-    snake->head->prev = new_head;
-    snake->head = new_head;
+    /* Push new head into the slot in front of the old head */
+    snake->head_index = (snake->head_index + snake->capacity - 1) % snake->capacity;
+    snake->body[snake->head_index] = new_head_pos;
+    snake_occupy(snake, new_head_pos, snake->head_index);
 
     if (grow) {
         /* Growing: keep tail, increment length and score */
         snake->length++;
         snake->score++;
     } else {
-        /* Not growing: remove tail */
-        if (snake->tail && snake->tail->prev) {
-            SnakeSegment* old_tail = snake->tail;
-            snake->tail = old_tail->prev;
-            snake->tail->next = NULL;
-            memory_tracked_free(old_tail);
-        }
+        /* Not growing: drop tail (it sits `length` slots behind the new head) */
+        size_t tail_index = (snake->head_index + snake->length) % snake->capacity;
+        snake_vacate(snake, snake->body[tail_index]);
     }
 
     return SUCCESS;
@@ -141,16 +211,18 @@ bool snake_collides_with_self(const Snake* snake, Position pos) {
         return false;
     }
 
+    long cell = snake_cell_index(snake, pos);
+    if (cell < 0) {
+        return false;
+    }
+
     /* Check collision with body (skip head) */
-    SnakeSegment* current = snake->head->next;
-    while (current) {
-        if (position_equals(current->pos, pos)) {
-            return true;
-        }
-        current = current->next;
+    unsigned int segments = snake->cell_count[cell];
+    if (position_equals(pos, snake_head(snake))) {
+        segments--;
     }
 
-    return false;
+    return segments > 0;
 }
 
 bool snake_contains_position(const Snake* snake, Position pos) {
@@ -158,37 +230,28 @@ bool snake_contains_position(const Snake* snake, Position pos) {
         return false;
     }
 
-    SnakeSegment* current = snake->head;
-    while (current) {
-        if (position_equals(current->pos, pos)) {
-            return true;
-        }
-        current = current->next;
-    }
-
-    return false;
+    long cell = snake_cell_index(snake, pos);
+    return cell >= 0 && snake->cell_count[cell] > 0;
 }
 
-SnakeSegment* snake_get_segment_at(const Snake* snake, Position pos) {
+int snake_get_segment_at(const Snake* snake, Position pos) {
     if (!snake) {
-        return NULL;
+        return -1;
     }
 
-    SnakeSegment* current = snake->head;
-    while (current) {
-        if (position_equals(current->pos, pos)) {
-            return current;
-        }
-        current = current->next;
+    long cell = snake_cell_index(snake, pos);
+    if (cell < 0 || snake->cell_count[cell] == 0) {
+        return -1;
     }
 
-    return NULL;
+    size_t slot = snake->cell_slot[cell];
+    return (int)((slot + snake->capacity - snake->head_index) % snake->capacity);
 }
 
 Position snake_get_next_head_position(const Snake* snake) {
-    if (!snake || !snake->head) {
+    if (!snake) {
         return (Position){-1, -1};
     }
 
-    return position_move(snake->head->pos, snake->next_direction);
+    return position_move(snake_head(snake), snake->next_direction);
 }
@@ -3,23 +3,32 @@
 
 #include "../../include/common.h"
 
-/**
- * Snake segment (doubly linked list node)
- * Represents one cell of the snake's body
- */
-typedef struct SnakeSegment {
-    Position pos;
-    struct SnakeSegment* next;
-    struct SnakeSegment* prev;
-} SnakeSegment;
-
 /**
  * Snake structure
- * Doubly linked list with head and tail pointers for O(1) operations
+ * Ring buffer of segment positions plus a per-cell occupancy index.
+ *
+ * - body[head_index] is the head; segment i (0 = head) lives in
+ *   body[(head_index + i) % capacity]
+ * - Moving pushes a new head slot in front and drops the tail slot, so
+ *   snake_move never allocates
+ * - cell_count/cell_slot map every board cell to the segment on it, making
+ *   position queries O(1) instead of a walk over the body
+ * - free_cells holds the indices of all unoccupied cells densely, with
+ *   free_slot giving each free cell's position in it (swap-remove when a
+ *   cell is occupied, append when it is vacated), so picking a random free
+ *   cell is O(1)
  */
 typedef struct {
-    SnakeSegment* head;
-    SnakeSegment* tail;
+    Position* body;          /* Ring buffer of segment positions */
+    size_t capacity;         /* Ring size: board cells + 1 */
+    size_t head_index;       /* Ring slot of the head */
+    uint8_t* cell_count;     /* Segments on each cell (2 only after a self-collision) */
+    uint32_t* cell_slot;     /* Ring slot of the segment on each occupied cell */
+    uint32_t* free_cells;    /* Dense array of unoccupied cell indices */
+    uint32_t* free_slot;     /* Index into free_cells of each unoccupied cell */
+    size_t free_count;       /* Number of unoccupied cells */
+    int grid_width;
+    int grid_height;
     Direction current_direction;
     Direction next_direction;
     size_t length;
@@ -30,16 +39,27 @@ typedef struct {
  * Create a new snake with initial position and direction
  * @param initial_pos Starting position for snake head
  * @param initial_dir Starting direction
+ * @param grid_width Board width (sizes the occupancy index)
+ * @param grid_height Board height (sizes the occupancy index)
  * @return Pointer to new snake or NULL on failure
  */
-Snake* snake_create(Position initial_pos, Direction initial_dir);
+Snake* snake_create(Position initial_pos, Direction initial_dir, int grid_width, int grid_height);
 
 /**
- * Destroy snake and free all segments
+ * Destroy snake and free its buffers
  * @param snake Snake to destroy
  */
 void snake_destroy(Snake* snake);
 
+/**
+ * Copy a snake (body and occupancy index) into another of the same board size
+ * O(cells); no allocation
+ * @param dst Snake to overwrite
+ * @param src Snake to copy
+ * @return SUCCESS, ERROR_NULL_POINTER, or ERROR_INVALID_POSITION if the board sizes differ
+ */
+ResultCode snake_copy(Snake* dst, const Snake* src);
+
 /**
  * Move the snake one step forward
  * @param snake Snake to move
@@ -74,12 +94,62 @@ bool snake_collides_with_self(const Snake* snake, Position pos);
 bool snake_contains_position(const Snake* snake, Position pos);
 
 /**
- * Get the segment at a specific position
+ * Get the index of the segment at a specific position
  * @param snake Snake to search
  * @param pos Position to find
- * @return Pointer to segment or NULL if not found
+ * @return Segment index (0 = head, length - 1 = tail) or -1 if not found
+ */
+int snake_get_segment_at(const Snake* snake, Position pos);
+
+/**
+ * Get the position of a segment
+ * @param snake Snake to query
+ * @param index Segment index (0 = head, must be < length)
+ * @return Segment position
+ */
+static inline Position snake_get_segment(const Snake* snake, size_t index) {
+    return snake->body[(snake->head_index + index) % snake->capacity];
+}
+
+/**
+ * Get the head position
+ * @param snake Snake to query
+ * @return Head position
+ */
+static inline Position snake_head(const Snake* snake) {
+    return snake->body[snake->head_index];
+}
+
+/**
+ * Get the tail position
+ * @param snake Snake to query
+ * @return Tail position
+ */
+static inline Position snake_tail(const Snake* snake) {
+    return snake_get_segment(snake, snake->length - 1);
+}
+
+/**
+ * Get the number of board cells not covered by the snake
+ * @param snake Snake to query
+ * @return Free cell count
+ */
+static inline size_t snake_free_cell_count(const Snake* snake) {
+    return snake->free_count;
+}
+
+/**
+ * Get a free cell by its index in the free set
+ * Order within the set is arbitrary and changes as the snake moves.
+ * @param snake Snake to query
+ * @param index Index into the free set (must be < snake_free_cell_count)
+ * @return Position of the free cell
  */
-SnakeSegment* snake_get_segment_at(const Snake* snake, Position pos);
+static inline Position snake_free_cell(const Snake* snake, size_t index) {
+    uint32_t cell = snake->free_cells[index];
+    return (Position){(int)(cell % (uint32_t)snake->grid_width),
+                      (int)(cell / (uint32_t)snake->grid_width)};
+}
 
 /**
  * Get the position where the head will be after moving in current direction
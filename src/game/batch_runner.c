@@ -0,0 +1,206 @@
+#define _POSIX_C_SOURCE 200112L
+#include "batch_runner.h"
+#include "../utils/memory_tracker.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+/* Range of game indices still owned by one worker: [begin, end) */
+typedef struct {
+    pthread_mutex_t lock;
+    unsigned long begin;
+    unsigned long end;
+} WorkRange;
+
+/* Shared state of one batch run */
+typedef struct {
+    const BatchConfig* config;
+    GameResult* results;
+    WorkRange* ranges;
+    unsigned int worker_count;
+    atomic_ulong unclaimed;     /* Games not yet taken by any worker */
+} BatchContext;
+
+/* Per-thread argument */
+typedef struct {
+    BatchContext* context;
+    unsigned int id;
+    ResultCode status;
+} Worker;
+
+/* Take the next game from the front of a worker's own range */
+static bool worker_take_own(BatchContext* context, WorkRange* range, unsigned long* out_index) {
+    bool found = false;
+
+    pthread_mutex_lock(&range->lock);
+    if (range->begin < range->end) {
+        *out_index = range->begin++;
+        found = true;
+    }
+    pthread_mutex_unlock(&range->lock);
+
+    if (found) {
+        atomic_fetch_sub_explicit(&context->unclaimed, 1, memory_order_relaxed);
+    }
+
+    return found;
+}
+
+/*
+ * Steal the back half of the first non-empty victim range
+ * Victims are scanned starting after the thief so that idle workers spread
+ * out over different victims instead of all contending for worker 0.
+ */
+static bool worker_steal(BatchContext* context, unsigned int thief) {
+    for (unsigned int offset = 1; offset < context->worker_count; offset++) {
+        WorkRange* victim = &context->ranges[(thief + offset) % context->worker_count];
+
+        unsigned long stolen_begin = 0;
+        unsigned long stolen_end = 0;
+
+        pthread_mutex_lock(&victim->lock);
+        unsigned long remaining = victim->end - victim->begin;
+        if (victim->begin < victim->end) {
+            stolen_end = victim->end;
+            stolen_begin = victim->end - (remaining + 1) / 2;
+            victim->end = stolen_begin;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (stolen_begin < stolen_end) {
+            WorkRange* own = &context->ranges[thief];
+            pthread_mutex_lock(&own->lock);
+            own->begin = stolen_begin;
+            own->end = stolen_end;
+            pthread_mutex_unlock(&own->lock);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void* worker_main(void* arg) {
+    Worker* worker = (Worker*)arg;
+    BatchContext* context = worker->context;
+    WorkRange* own = &context->ranges[worker->id];
+    const volatile sig_atomic_t* running = context->config->running;
+
+    worker->status = SUCCESS;
+
+    while (!running || *running) {
+        unsigned long index;
+
+        if (!worker_take_own(context, own, &index)) {
+            if (worker_steal(context, worker->id)) {
+                continue;
+            }
+
+            /*
+             * A failed steal does not mean the batch is done: a steal in
+             * progress holds its games in no range until the thief installs
+             * them as its own. Only once every game has been taken is there
+             * nothing left to wait for.
+             */
+            if (atomic_load_explicit(&context->unclaimed, memory_order_relaxed) == 0) {
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+
+        uint64_t seed = context->config->first_seed + (uint64_t)index;
+        ResultCode result = simulation_run_game(&context->config->game, seed,
+                                                &context->results[index]);
+        if (result != SUCCESS) {
+            worker->status = result;
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+ResultCode batch_run(const BatchConfig* config, GameResult* results) {
+    if (!config || !results) {
+        return ERROR_NULL_POINTER;
+    }
+
+    for (unsigned long i = 0; i < config->games; i++) {
+        results[i].seed = config->first_seed + (uint64_t)i;
+        results[i].completed = false;
+    }
+
+    if (config->games == 0) {
+        return SUCCESS;
+    }
+
+    unsigned int worker_count = config->threads ? config->threads : batch_default_thread_count();
+    if (worker_count > config->games) {
+        worker_count = (unsigned int)config->games;
+    }
+
+    WorkRange* ranges = (WorkRange*)memory_tracked_malloc(sizeof(WorkRange) * worker_count);
+    Worker* workers = (Worker*)memory_tracked_malloc(sizeof(Worker) * worker_count);
+    pthread_t* threads = (pthread_t*)memory_tracked_malloc(sizeof(pthread_t) * worker_count);
+    if (!ranges || !workers || !threads) {
+        memory_tracked_free(ranges);
+        memory_tracked_free(workers);
+        memory_tracked_free(threads);
+        return ERROR_OUT_OF_MEMORY;
+    }
+
+    BatchContext context;
+    context.config = config;
+    context.results = results;
+    context.ranges = ranges;
+    context.worker_count = worker_count;
+    atomic_init(&context.unclaimed, config->games);
+
+    /* Initial even split of game indices */
+    for (unsigned int i = 0; i < worker_count; i++) {
+        pthread_mutex_init(&ranges[i].lock, NULL);
+        ranges[i].begin = config->games * i / worker_count;
+        ranges[i].end = config->games * (i + 1) / worker_count;
+
+        workers[i].context = &context;
+        workers[i].id = i;
+        workers[i].status = SUCCESS;
+    }
+
+    /* Worker 0 runs on the calling thread */
+    unsigned int started = 1;
+    for (unsigned int i = 1; i < worker_count; i++) {
+        if (pthread_create(&threads[i], NULL, worker_main, &workers[i]) != 0) {
+            /* Ranges of workers that never started are stolen by the others */
+            break;
+        }
+        started++;
+    }
+
+    worker_main(&workers[0]);
+
+    for (unsigned int i = 1; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    ResultCode status = SUCCESS;
+    for (unsigned int i = 0; i < worker_count; i++) {
+        if (workers[i].status != SUCCESS) {
+            status = workers[i].status;
+        }
+        pthread_mutex_destroy(&ranges[i].lock);
+    }
+
+    memory_tracked_free(ranges);
+    memory_tracked_free(workers);
+    memory_tracked_free(threads);
+
+    return status;
+}
+
+unsigned int batch_default_thread_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (unsigned int)count : 1;
+}
@@ -0,0 +1,47 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <signal.h>
+#include "../../include/common.h"
+#include "simulation.h"
+
+/**
+ * Batch Runner Module
+ *
+ * Spreads independent headless games over a pool of worker threads.
+ *
+ * Work distribution:
+ * 1. The game indices [0, games) are split into one contiguous range per worker
+ * 2. Each worker plays games from the front of its own range
+ * 3. A worker whose range is empty steals the back half of a busy worker's range
+ * 4. Results are written by game index, so the merged output does not depend
+ *    on thread count or scheduling
+ */
+
+/**
+ * Batch configuration
+ */
+typedef struct {
+    SimulationConfig game;                  /* Settings for every game */
+    unsigned long games;                    /* Number of games to play */
+    uint64_t first_seed;                    /* Game i is seeded with first_seed + i */
+    unsigned int threads;                   /* Worker count (0 = one per online CPU) */
+    const volatile sig_atomic_t* running;   /* Optional: stop taking games when cleared */
+} BatchConfig;
+
+/**
+ * Play a batch of games on a worker pool
+ * Games skipped because `running` was cleared have completed == false.
+ * @param config Batch configuration
+ * @param results Output array with one entry per game (config->games entries)
+ * @return SUCCESS or error code
+ */
+ResultCode batch_run(const BatchConfig* config, GameResult* results);
+
+/**
+ * Get the number of online CPUs
+ * @return CPU count (at least 1)
+ */
+unsigned int batch_default_thread_count(void);
+
+#endif /* BATCH_RUNNER_H */
@@ -1,34 +1,38 @@
 #include "game_state.h"
 #include "../utils/memory_tracker.h"
 #include <stdlib.h>
-#include <time.h>
+#include <string.h>
+#include <assert.h>
 
-GameState* game_state_create(GameMode mode) {
+GameState* game_state_create(GameMode mode, int width, int height, uint64_t seed) {
     GameState* state = (GameState*)memory_tracked_malloc(sizeof(GameState));
     if (!state) {
         return NULL;
     }
 
-    /* Initialize random number generator */
-    srand((unsigned int)time(NULL));
+    /* Initialize grid */
+    if (grid_init(&state->grid, width, height) != SUCCESS) {
+        memory_tracked_free(state);
+        return NULL;
+    }
 
     /* Create snake in center, moving right */
-    Position start_pos = {GRID_WIDTH / 2, GRID_HEIGHT / 2};
-    state->snake = snake_create(start_pos, DIR_RIGHT);
+    Position start_pos = {width / 2, height / 2};
+    state->snake = snake_create(start_pos, DIR_RIGHT, state->grid.width, state->grid.height);
     if (!state->snake) {
+        grid_destroy(&state->grid);
         memory_tracked_free(state);
         return NULL;
     }
 
-    /* Initialize grid */
-    grid_init(&state->grid);
-
     /* Set initial state */
     state->mode = mode;
     state->status = GAME_RUNNING;
     state->moves_count = 0;
+    state->generation = 0;
     state->total_ai_time_us = 0;
     state->peak_memory_bytes = 0;
+    rng_seed(&state->rng, seed);
     state->show_path_overlay = true;
     state->show_safety_check = true;
 
@@ -48,9 +52,36 @@ void game_state_destroy(GameState* state) {
         snake_destroy(state->snake);
     }
 
+    grid_destroy(&state->grid);
     memory_tracked_free(state);
 }
 
+ResultCode game_state_copy(GameState* dst, const GameState* src) {
+    if (!dst || !src || !dst->snake || !src->snake) {
+        return ERROR_NULL_POINTER;
+    }
+
+    ResultCode status = grid_copy(&dst->grid, &src->grid);
+    if (status == SUCCESS) {
+        status = snake_copy(dst->snake, src->snake);
+    }
+    if (status != SUCCESS) {
+        return status;
+    }
+
+    dst->mode = src->mode;
+    dst->status = src->status;
+    dst->moves_count = src->moves_count;
+    dst->generation = src->generation;
+    dst->total_ai_time_us = src->total_ai_time_us;
+    dst->peak_memory_bytes = src->peak_memory_bytes;
+    dst->rng = src->rng;
+    dst->show_path_overlay = src->show_path_overlay;
+    dst->show_safety_check = src->show_safety_check;
+
+    return SUCCESS;
+}
+
 void game_state_reset(GameState* state) {
     if (!state) {
         return;
@@ -62,15 +93,17 @@ void game_state_reset(GameState* state) {
     }
 
     /* Create new snake */
-    Position start_pos = {GRID_WIDTH / 2, GRID_HEIGHT / 2};
-    state->snake = snake_create(start_pos, DIR_RIGHT);
+    Position start_pos = {state->grid.width / 2, state->grid.height / 2};
+    state->snake = snake_create(start_pos, DIR_RIGHT, state->grid.width, state->grid.height);
 
-    /* Reset grid */
-    grid_init(&state->grid);
+    /* Reset grid (keeps its storage) */
+    grid_clear(&state->grid);
+    state->grid.food_pos = (Position){-1, -1};
 
     /* Reset state variables */
     state->status = GAME_RUNNING;
     state->moves_count = 0;
+    state->generation++;
     state->total_ai_time_us = 0;
 
     /* Sync and spawn food */
@@ -98,6 +131,10 @@ ResultCode game_state_update(GameState* state, Direction input_dir) {
     /* Check if snake will eat food */
     bool will_eat = position_equals(next_pos, state->grid.food_pos);
 
+    /* Remember the cells the move will change on the grid */
+    Position old_head = snake_head(state->snake);
+    Position old_tail = snake_tail(state->snake);
+
     /* Move snake */
     ResultCode result = snake_move(state->snake, will_eat);
     if (result != SUCCESS) {
@@ -108,21 +145,28 @@ ResultCode game_state_update(GameState* state, Direction input_dir) {
 
     /* Check for collisions */
     if (game_state_check_collision(state)) {
+        /*
+         * Keep the grid and its hash matching the final snake for the
+         * renderer and post-mortem analysis. The head is off the board or on
+         * a body cell, which the incremental update does not model, so this
+         * once-per-game sync is a full rebuild.
+         */
+        game_state_sync_grid(state);
         state->status = GAME_OVER;
         return ERROR_COLLISION;
     }
 
+    /* Only the cells around the head and tail changed */
+    game_state_sync_grid_incremental(state, old_head, old_tail, will_eat);
+
     /* If ate food, spawn new food */
     if (will_eat) {
-        game_state_sync_grid(state);
         game_state_spawn_food(state);
 
         /* Check for win condition */
         if (game_state_check_win(state)) {
             state->status = GAME_WON;
         }
-    } else {
-        game_state_sync_grid(state);
     }
 
     /* Update peak memory */
@@ -139,18 +183,8 @@ void game_state_spawn_food(GameState* state) {
         return;
     }
 
-    /* Find all empty positions */
-    Position empty_positions[GRID_SIZE];
-    int empty_count = 0;
-
-    for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            Position pos = {x, y};
-            if (!snake_contains_position(state->snake, pos)) {
-                empty_positions[empty_count++] = pos;
-            }
-        }
-    }
+    /* The snake keeps the set of free cells, so the draw is O(1) */
+    size_t empty_count = snake_free_cell_count(state->snake);
 
     /* No empty positions? Game won! */
     if (empty_count == 0) {
@@ -159,20 +193,25 @@ void game_state_spawn_food(GameState* state) {
     }
 
     /* Pick random empty position */
-    int random_index = rand() % empty_count;
-    state->grid.food_pos = empty_positions[random_index];
+    size_t random_index = rng_bounded(&state->rng, (uint32_t)empty_count);
+    state->grid.food_pos = snake_free_cell(state->snake, random_index);
+
+#ifdef OUROBOROS_DEBUG_CHECKS
+    assert(!snake_contains_position(state->snake, state->grid.food_pos));
+#endif
+
     grid_set_cell(&state->grid, state->grid.food_pos, CELL_FOOD);
 }
 
 bool game_state_check_collision(const GameState* state) {
-    if (!state || !state->snake || !state->snake->head) {
+    if (!state || !state->snake) {
         return true;
     }
 
-    Position head_pos = state->snake->head->pos;
+    Position head_pos = snake_head(state->snake);
 
     /* Check wall collision */
-    if (!grid_is_valid_position(head_pos)) {
+    if (!grid_is_valid_position(&state->grid, head_pos)) {
         return true;
     }
 
@@ -193,29 +232,75 @@ void game_state_sync_grid(GameState* state) {
     grid_clear(&state->grid);
 
     /* Place food back */
-    if (grid_is_valid_position(state->grid.food_pos)) {
+    if (grid_is_valid_position(&state->grid, state->grid.food_pos)) {
         grid_set_cell(&state->grid, state->grid.food_pos, CELL_FOOD);
     }
 
-    /* Place snake segments */
-    SnakeSegment* current = state->snake->head;
+    /* Place snake segments: head, body, tail */
+    const Snake* snake = state->snake;
+    for (size_t i = 0; i < snake->length; i++) {
+        CellType type = CELL_SNAKE_BODY;
+        if (i == 0) {
+            type = CELL_SNAKE_HEAD;
+        } else if (i == snake->length - 1) {
+            type = CELL_SNAKE_TAIL;
+        }
+        grid_set_cell(&state->grid, snake_get_segment(snake, i), type);
+    }
+}
+
+#ifdef OUROBOROS_DEBUG_CHECKS
+/* Cross-check: the incrementally updated grid must match a full rebuild */
+static void game_state_verify_grid(GameState* state) {
+    size_t cell_count = grid_cell_count(&state->grid);
+    uint8_t* incremental = (uint8_t*)memory_tracked_malloc(cell_count);
+    if (!incremental) {
+        return;
+    }
+
+    memcpy(incremental, state->grid.types, cell_count);
+    uint64_t incremental_hash = grid_hash(&state->grid);
+
+    game_state_sync_grid(state);
+    assert(memcmp(incremental, state->grid.types, cell_count) == 0);
+    assert(incremental_hash == grid_hash(&state->grid));
+    assert(incremental_hash == grid_compute_hash(&state->grid));
+
+    memory_tracked_free(incremental);
+}
+#endif
 
-    /* Head */
-    if (current) {
-        grid_set_cell(&state->grid, current->pos, CELL_SNAKE_HEAD);
-        current = current->next;
+void game_state_sync_grid_incremental(GameState* state, Position old_head,
+                                      Position old_tail, bool grew) {
+    if (!state || !state->snake) {
+        return;
     }
 
-    /* Body */
-    while (current && current->next) {
-        grid_set_cell(&state->grid, current->pos, CELL_SNAKE_BODY);
-        current = current->next;
+    Grid* grid = &state->grid;
+    const Snake* snake = state->snake;
+
+    /*
+     * Write order matters when cells coincide: the vacated tail is cleared
+     * first so a head moving into it (tail chasing) ends up as HEAD, and the
+     * old head is demoted before the new tail is marked so a two-segment
+     * snake gets its tail right.
+     */
+    if (!grew) {
+        grid_set_cell(grid, old_tail, CELL_EMPTY);
     }
 
-    /* Tail */
-    if (current) {
-        grid_set_cell(&state->grid, current->pos, CELL_SNAKE_TAIL);
+    grid_set_cell(grid, old_head, CELL_SNAKE_BODY);
+
+    if (snake->length > 1) {
+        grid_set_cell(grid, snake_tail(snake), CELL_SNAKE_TAIL);
     }
+
+    /* Covers the food cell when the move ate it */
+    grid_set_cell(grid, snake_head(snake), CELL_SNAKE_HEAD);
+
+#ifdef OUROBOROS_DEBUG_CHECKS
+    game_state_verify_grid(state);
+#endif
 }
 
 bool game_state_check_win(const GameState* state) {
@@ -224,5 +309,5 @@ bool game_state_check_win(const GameState* state) {
     }
 
     /* Win condition: snake length equals grid size (perfect game) */
-    return state->snake->length >= GRID_SIZE;
+    return state->snake->length >= grid_cell_count(&state->grid);
 }
@@ -4,6 +4,7 @@
 #include "../../include/common.h"
 #include "../data_structures/snake.h"
 #include "../data_structures/grid.h"
+#include "../utils/rng.h"
 
 /**
  * Central game state management
@@ -15,8 +16,10 @@ typedef struct {
     GameMode mode;
     GameStatus status;
     uint32_t moves_count;
+    uint32_t generation;           /* Bumped by game_state_reset: tells restarted games apart */
     uint64_t total_ai_time_us;     /* Accumulated AI decision time */
     uint64_t peak_memory_bytes;
+    Rng rng;                       /* Per-game generator for food placement */
     bool show_path_overlay;
     bool show_safety_check;
 } GameState;
@@ -24,9 +27,12 @@ typedef struct {
 /**
  * Create a new game state
  * @param mode Game mode (manual or AI)
+ * @param width Board width in cells
+ * @param height Board height in cells
+ * @param seed Seed for this game's food placement (same seed, same game)
  * @return Pointer to new game state or NULL on failure
  */
-GameState* game_state_create(GameMode mode);
+GameState* game_state_create(GameMode mode, int width, int height, uint64_t seed);
 
 /**
  * Destroy game state and free resources
@@ -34,8 +40,20 @@ GameState* game_state_create(GameMode mode);
  */
 void game_state_destroy(GameState* state);
 
+/**
+ * Copy a game state into another of the same board size (a snapshot)
+ * O(cells); no allocation. The copy can be searched and updated without
+ * touching the original.
+ * @param dst State to overwrite
+ * @param src State to copy
+ * @return SUCCESS or error code (ERROR_INVALID_POSITION if the board sizes differ)
+ */
+ResultCode game_state_copy(GameState* dst, const GameState* src);
+
 /**
  * Reset game to initial state
+ * Starts a new generation, so state cached per game (e.g. by an AI
+ * controller) can tell the new game from the old one.
  * @param state Game state to reset
  */
 void game_state_reset(GameState* state);
@@ -63,11 +81,24 @@ bool game_state_check_collision(const GameState* state);
 
 /**
  * Synchronize grid with current snake position
- * Updates grid cells to reflect snake body
+ * Full rebuild: clears the grid and rewrites food and every snake segment
  * @param state Game state to synchronize
  */
 void game_state_sync_grid(GameState* state);
 
+/**
+ * Bring the grid up to date after one snake_move in O(1)
+ * Only the new head, previous head, new tail and vacated tail cells change
+ * (the new head also covers eaten food). Builds with OUROBOROS_DEBUG_CHECKS
+ * verify the result against game_state_sync_grid.
+ * @param state Game state whose snake just moved
+ * @param old_head Head position before the move
+ * @param old_tail Tail position before the move
+ * @param grew Whether the move grew the snake (tail stayed in place)
+ */
+void game_state_sync_grid_incremental(GameState* state, Position old_head,
+                                      Position old_tail, bool grew);
+
 /**
  * Check if game is won (perfect game - all cells visited)
  * @param state Game state to check
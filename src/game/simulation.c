@@ -0,0 +1,117 @@
+#include "simulation.h"
+#include "game_state.h"
+#include "../ai/ai_controller.h"
+#include "../ai/pathfinding.h"
+
+/* Search the tick's board with every pathfinder; the selected one already ran */
+static void simulation_compare_paths(AIController* controller, GameState* state,
+                                     const PathResult* selected, GameResult* result) {
+    if (selected->timed_out) {
+        return;  /* Cut off by the budget: no count to pair with */
+    }
+
+    result->paired_searches++;
+
+    for (int a = 0; a < PATH_ALGORITHM_COUNT; a++) {
+        const PathResult* path = selected;
+        if ((PathAlgorithm)a != controller->path_algorithm) {
+            /* Results land in the decision's arena, which the next decision resets */
+            path = pathfinding_find_path((PathAlgorithm)a, &state->grid, controller->workspace,
+                                         state->snake, state->grid.food_pos);
+        }
+
+        if (path) {
+            result->paired_nodes[a] += path->nodes_expanded;
+            result->paired_found[a] += path->found;
+        }
+    }
+}
+
+ResultCode simulation_run_game(const SimulationConfig* config, uint64_t seed, GameResult* result) {
+    if (!config || !result) {
+        return ERROR_NULL_POINTER;
+    }
+
+    result->seed = seed;
+    result->score = 0;
+    result->moves = 0;
+    result->final_length = 0;
+    result->won = false;
+    result->stalled = false;
+    result->total_ai_time_us = 0;
+    result->max_decision_time_us = 0;
+    result->deadline_hits = 0;
+    result->path_searches = 0;
+    result->path_nodes_expanded = 0;
+    result->paths_found = 0;
+    result->paired_searches = 0;
+    for (int a = 0; a < PATH_ALGORITHM_COUNT; a++) {
+        result->paired_nodes[a] = 0;
+        result->paired_found[a] = 0;
+    }
+    result->completed = false;
+
+    GameState* state = game_state_create(MODE_AI_DEMO, config->grid_width,
+                                         config->grid_height, seed);
+    if (!state) {
+        return ERROR_OUT_OF_MEMORY;
+    }
+
+    AIController* controller = ai_controller_create(config->grid_width, config->grid_height,
+                                                    config->strategy);
+    if (!controller) {
+        game_state_destroy(state);
+        return ERROR_OUT_OF_MEMORY;
+    }
+
+    controller->path_algorithm = config->path_algorithm;
+    controller->time_budget_us = (uint64_t)config->time_budget_ms * 1000ULL;
+
+    uint32_t stall_limit = SIMULATION_STALL_FACTOR * (uint32_t)grid_cell_count(&state->grid);
+    uint32_t moves_since_food = 0;
+
+    while (state->status == GAME_RUNNING) {
+        Direction input_dir = DIR_NONE;
+
+        AIDecision* decision = ai_make_decision(controller, state);
+        if (decision) {
+            input_dir = decision->chosen_direction;
+            if (decision->total_compute_time_us > result->max_decision_time_us) {
+                result->max_decision_time_us = decision->total_compute_time_us;
+            }
+            result->deadline_hits += decision->hit_deadline;
+            if (decision->path_to_food) {
+                result->path_searches++;
+                result->path_nodes_expanded += decision->path_to_food->nodes_expanded;
+                result->paths_found += decision->path_to_food->found;
+
+                if (config->compare_paths) {
+                    simulation_compare_paths(controller, state, decision->path_to_food, result);
+                }
+            }
+        }
+
+        uint32_t score_before = state->snake->score;
+        game_state_update(state, input_dir);
+        ai_controller_on_move(controller, state, input_dir);
+
+        if (state->snake->score != score_before) {
+            moves_since_food = 0;
+        } else if (++moves_since_food >= stall_limit) {
+            result->stalled = true;
+            break;
+        }
+    }
+
+    result->score = state->snake->score;
+    result->moves = state->moves_count;
+    result->final_length = state->snake->length;
+    result->won = (state->status == GAME_WON);
+    result->total_ai_time_us = state->total_ai_time_us;
+    result->completed = true;
+
+    ai_controller_destroy(controller);
+    game_state_destroy(state);
+
+    return SUCCESS;
+}
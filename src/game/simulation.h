@@ -0,0 +1,67 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "../../include/common.h"
+#include "../ai/strategy.h"
+
+/**
+ * Headless Simulation Module
+ *
+ * Runs complete AI games without rendering, frame pacing or input polling.
+ * Used for batch evaluation of the AI: every game runs as fast as the CPU allows.
+ * Games share no mutable state, so they may run concurrently on several threads.
+ */
+
+/**
+ * Settings shared by every game of a headless run
+ */
+typedef struct {
+    int grid_width;                 /* Board width in cells */
+    int grid_height;                /* Board height in cells */
+    const AIStrategyOps* strategy;  /* AI decision strategy (see ai_strategy_find) */
+    PathAlgorithm path_algorithm;   /* Search for the path to food */
+    uint32_t time_budget_ms;        /* Anytime decisions: budget per move, 0 = unbounded */
+    bool compare_paths;             /* Shadow-run every pathfinder on each searched board */
+} SimulationConfig;
+
+/**
+ * Per-game statistics collected by a headless run
+ */
+typedef struct {
+    uint64_t seed;                  /* Seed the game was played with */
+    uint32_t score;                 /* Food eaten */
+    uint32_t moves;                 /* Moves made before the game ended */
+    size_t final_length;            /* Snake length at the end of the game */
+    bool won;                       /* Perfect game (board filled) */
+    bool stalled;                   /* Stopped after too many moves without food */
+    uint64_t total_ai_time_us;      /* Accumulated AI decision time */
+    uint64_t max_decision_time_us;  /* Slowest single AI decision */
+    uint64_t deadline_hits;         /* Decisions cut short by the time budget */
+    uint64_t path_searches;         /* Paths to food searched */
+    uint64_t path_nodes_expanded;   /* Cells expanded by those searches */
+    uint64_t paths_found;           /* Searches that reached the food */
+    uint64_t paired_searches;       /* Boards searched by every pathfinder (compare_paths) */
+    uint64_t paired_nodes[PATH_ALGORITHM_COUNT];  /* Cells expanded on them, per algorithm */
+    uint64_t paired_found[PATH_ALGORITHM_COUNT];  /* Of them, food reached, per algorithm */
+    bool completed;                 /* Game was actually played to the end */
+} GameResult;
+
+/**
+ * Play one complete AI game headlessly
+ *
+ * The loop is ai_make_decision -> game_state_update until the game is won,
+ * lost, or the snake goes SIMULATION_STALL_FACTOR * (width * height) moves
+ * without eating (an AI stuck in a loop would otherwise never terminate).
+ *
+ * With compare_paths, every board the AI searched for food is searched again
+ * by the other pathfinders (in shadow: the game follows the configured one),
+ * so the per-algorithm counters are paired board by board.
+ *
+ * @param config Board settings
+ * @param seed Seed for food placement
+ * @param result Output parameter for game statistics
+ * @return SUCCESS or error code
+ */
+ResultCode simulation_run_game(const SimulationConfig* config, uint64_t seed, GameResult* result);
+
+#endif /* SIMULATION_H */
@@ -2,13 +2,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <limits.h>
 #include <time.h>
 #include <unistd.h>
 #include <signal.h>
 #include <ncurses.h>
 #include "../include/common.h"
 #include "game/game_state.h"
+#include "game/simulation.h"
+#include "game/batch_runner.h"
 #include "ai/ai_controller.h"
+#include "ai/ai_worker.h"
 #include "rendering/renderer.h"
 #include "utils/timer.h"
 #include "utils/memory_tracker.h"
@@ -66,6 +71,24 @@ void print_usage(const char* program_name) {
     fprintf(stderr, "\nOptions:\n");
     fprintf(stderr, "  -m, --manual    Manual play mode (default)\n");
     fprintf(stderr, "  -a, --ai        AI demonstration mode\n");
+    fprintf(stderr, "  --width W       Board width in cells (default %d)\n", DEFAULT_GRID_WIDTH);
+    fprintf(stderr, "  --height H      Board height in cells (default %d)\n", DEFAULT_GRID_HEIGHT);
+    fprintf(stderr, "  --strategy S    AI strategy (default %s):\n", ai_strategy_default()->name);
+    for (size_t i = 0; i < ai_strategy_count(); i++) {
+        const AIStrategyOps* strategy = ai_strategy_at(i);
+        fprintf(stderr, "                  %-12s %s\n", strategy->name, strategy->description);
+    }
+    fprintf(stderr, "  --pathfinder P  Path to food search: astar (default), bfs or timed\n");
+    fprintf(stderr, "                  (timed: BFS through body cells vacated in time)\n");
+    fprintf(stderr, "  --budget MS     Anytime AI: best move found within about MS ms,\n");
+    fprintf(stderr, "                  0 = unbounded (default %d interactive, unbounded headless)\n",
+            MAX_AI_COMPUTE_MS);
+    fprintf(stderr, "  --headless      Run AI games without rendering and print statistics\n");
+    fprintf(stderr, "  --games N       Number of headless games to play (default 1)\n");
+    fprintf(stderr, "  --seed S        Seed of the first headless game (default: time)\n");
+    fprintf(stderr, "  --compare-paths Headless: also run the other pathfinders on every board\n");
+    fprintf(stderr, "                  searched and report their node counts side by side\n");
+    fprintf(stderr, "  --threads T     Headless worker threads, 0 = all cores (default 1)\n");
     fprintf(stderr, "  -h, --help      Show this help message\n");
     fprintf(stderr, "\nControls (Manual Mode):\n");
     fprintf(stderr, "  Arrow Keys / WASD  -  Move snake\n");
@@ -73,12 +96,232 @@ void print_usage(const char* program_name) {
     fprintf(stderr, "  Q  -  Quit\n");
 }
 
+/* Parse an unsigned decimal option value, rejecting trailing garbage and values above max */
+static bool parse_uint_option(const char* text, uint64_t max, uint64_t* out) {
+    if (!text || !out || *text == '\0' || *text == '-') {
+        return false;
+    }
+
+    char* end = NULL;
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || value > max) {
+        return false;
+    }
+
+    *out = value;
+    return true;
+}
+
+/**
+ * Headless batch mode: play games as fast as possible on a worker pool
+ * Game i is seeded with first_seed + i, so any game can be replayed alone
+ * and the report is identical regardless of thread count
+ */
+/* Display name of a path search algorithm */
+static const char* path_algorithm_name(PathAlgorithm algorithm) {
+    switch (algorithm) {
+        case PATH_ALGORITHM_ASTAR:
+            return "A*";
+        case PATH_ALGORITHM_TIMED_BFS:
+            return "time-aware BFS";
+        case PATH_ALGORITHM_BFS:
+        default:
+            return "BFS";
+    }
+}
+
+static int run_headless(const SimulationConfig* game, unsigned long games,
+                        uint64_t first_seed, unsigned int threads) {
+    if (games == 0) {
+        return 0;
+    }
+
+    GameResult* results = (GameResult*)memory_tracked_malloc(sizeof(GameResult) * games);
+    if (!results) {
+        fprintf(stderr, "Failed to allocate results for %lu games\n", games);
+        return 1;
+    }
+
+    BatchConfig config = {*game, games, first_seed, threads, &g_running};
+    ResultCode status = batch_run(&config, results);
+
+    uint64_t total_score = 0;
+    uint64_t total_moves = 0;
+    uint64_t total_ai_time_us = 0;
+    uint64_t max_decision_time_us = 0;
+    uint64_t deadline_hits = 0;
+    uint64_t path_searches = 0;
+    uint64_t path_nodes_expanded = 0;
+    uint64_t paths_found = 0;
+    uint64_t paired_searches = 0;
+    uint64_t paired_nodes[PATH_ALGORITHM_COUNT] = {0};
+    uint64_t paired_found[PATH_ALGORITHM_COUNT] = {0};
+    unsigned long wins = 0;
+    unsigned long stalls = 0;
+    unsigned long played = 0;
+
+    printf("%-6s %-10s %6s %8s %4s %12s %12s\n",
+           "game", "seed", "score", "moves", "won", "ai_total_ms", "ai_avg_us");
+
+    /* Merge in game order */
+    for (unsigned long i = 0; i < games; i++) {
+        const GameResult* result = &results[i];
+        if (!result->completed) {
+            continue;
+        }
+
+        double avg_us = result->moves > 0 ?
+            (double)result->total_ai_time_us / result->moves : 0.0;
+
+        printf("%-6lu %-10llu %6u %8u %4s %12.2f %12.1f%s\n",
+               i, (unsigned long long)result->seed, result->score, result->moves,
+               result->won ? "yes" : "no",
+               result->total_ai_time_us / 1000.0, avg_us,
+               result->stalled ? "  (stalled)" : "");
+
+        total_score += result->score;
+        total_moves += result->moves;
+        total_ai_time_us += result->total_ai_time_us;
+        if (result->max_decision_time_us > max_decision_time_us) {
+            max_decision_time_us = result->max_decision_time_us;
+        }
+        deadline_hits += result->deadline_hits;
+        path_searches += result->path_searches;
+        path_nodes_expanded += result->path_nodes_expanded;
+        paths_found += result->paths_found;
+        paired_searches += result->paired_searches;
+        for (int a = 0; a < PATH_ALGORITHM_COUNT; a++) {
+            paired_nodes[a] += result->paired_nodes[a];
+            paired_found[a] += result->paired_found[a];
+        }
+        wins += result->won ? 1 : 0;
+        stalls += result->stalled ? 1 : 0;
+        played++;
+    }
+
+    memory_tracked_free(results);
+
+    if (status != SUCCESS) {
+        fprintf(stderr, "Batch run failed (error %d)\n", (int)status);
+        return 1;
+    }
+
+    if (played == 0) {
+        return 0;
+    }
+
+    printf("\nStrategy: %s\n", game->strategy->name);
+    printf("Games: %lu  Wins: %lu  Stalled: %lu\n", played, wins, stalls);
+    printf("Average Score: %.2f\n", (double)total_score / played);
+    printf("Average Moves: %.2f\n", (double)total_moves / played);
+    printf("AI Time: %.2f ms total, %.1f us/move, %.2f ms worst decision\n",
+           total_ai_time_us / 1000.0,
+           total_moves > 0 ? (double)total_ai_time_us / total_moves : 0.0,
+           max_decision_time_us / 1000.0);
+    if (game->time_budget_ms > 0) {
+        printf("Deadline: %llu of %llu decisions hit the %u ms budget\n",
+               (unsigned long long)deadline_hits, (unsigned long long)total_moves,
+               game->time_budget_ms);
+    }
+    if (path_searches > 0) {
+        printf("Path Search: %s, %.1f nodes expanded per search, food reached in %.1f%%\n",
+               path_algorithm_name(game->path_algorithm),
+               (double)path_nodes_expanded / path_searches,
+               100.0 * (double)paths_found / path_searches);
+    }
+    if (paired_searches > 0) {
+        printf("Paired Search: every pathfinder on the same %llu boards\n",
+               (unsigned long long)paired_searches);
+        for (int a = 0; a < PATH_ALGORITHM_COUNT; a++) {
+            printf("  %-15s %.1f nodes expanded per search, food reached in %.1f%%\n",
+                   path_algorithm_name((PathAlgorithm)a),
+                   (double)paired_nodes[a] / paired_searches,
+                   100.0 * (double)paired_found[a] / paired_searches);
+        }
+    }
+    printf("Peak Memory: %llu bytes\n", (unsigned long long)memory_get_peak_usage());
+
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     /* Parse command line arguments */
     GameMode mode = MODE_MANUAL;
+    bool headless = false;
+    unsigned long games = 1;
+    uint64_t seed = (uint64_t)time(NULL);
+    unsigned long threads = 1;
+    unsigned long width = DEFAULT_GRID_WIDTH;
+    unsigned long height = DEFAULT_GRID_HEIGHT;
+    const AIStrategyOps* strategy = ai_strategy_default();
+    PathAlgorithm path_algorithm = PATH_ALGORITHM_ASTAR;
+    unsigned long budget_ms = 0;
+    bool budget_set = false;
+    bool compare_paths = false;
 
     for (int i = 1; i < argc; i++) {
-        if (strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--ai") == 0) {
+        if (strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (strcmp(argv[i], "--compare-paths") == 0) {
+            compare_paths = true;
+        } else if (strcmp(argv[i], "--games") == 0 || strcmp(argv[i], "--seed") == 0 ||
+                   strcmp(argv[i], "--threads") == 0 || strcmp(argv[i], "--width") == 0 ||
+                   strcmp(argv[i], "--height") == 0 || strcmp(argv[i], "--budget") == 0) {
+            /* Largest value each option can carry without truncation */
+            uint64_t max = ULONG_MAX;
+            if (strcmp(argv[i], "--seed") == 0) {
+                max = UINT64_MAX;
+            } else if (strcmp(argv[i], "--threads") == 0) {
+                max = UINT_MAX;
+            } else if (strcmp(argv[i], "--budget") == 0) {
+                max = UINT32_MAX;
+            }
+
+            uint64_t value;
+            if (i + 1 >= argc || !parse_uint_option(argv[i + 1], max, &value)) {
+                fprintf(stderr, "Option %s requires an integer from 0 to %llu\n",
+                        argv[i], (unsigned long long)max);
+                print_usage(argv[0]);
+                return 1;
+            }
+            if (strcmp(argv[i], "--games") == 0) {
+                games = (unsigned long)value;
+            } else if (strcmp(argv[i], "--threads") == 0) {
+                threads = (unsigned long)value;
+            } else if (strcmp(argv[i], "--width") == 0) {
+                width = (unsigned long)value;
+            } else if (strcmp(argv[i], "--height") == 0) {
+                height = (unsigned long)value;
+            } else if (strcmp(argv[i], "--budget") == 0) {
+                budget_ms = (unsigned long)value;
+                budget_set = true;
+            } else {
+                seed = value;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--strategy") == 0) {
+            strategy = i + 1 < argc ? ai_strategy_find(argv[i + 1]) : NULL;
+            if (!strategy) {
+                fprintf(stderr, "Option --strategy requires a strategy name\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--pathfinder") == 0) {
+            if (i + 1 < argc && strcmp(argv[i + 1], "astar") == 0) {
+                path_algorithm = PATH_ALGORITHM_ASTAR;
+            } else if (i + 1 < argc && strcmp(argv[i + 1], "bfs") == 0) {
+                path_algorithm = PATH_ALGORITHM_BFS;
+            } else if (i + 1 < argc && strcmp(argv[i + 1], "timed") == 0) {
+                path_algorithm = PATH_ALGORITHM_TIMED_BFS;
+            } else {
+                fprintf(stderr, "Option --pathfinder requires 'astar', 'bfs' or 'timed'\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--ai") == 0) {
             mode = MODE_AI_DEMO;
         } else if (strcmp(argv[i], "-m") == 0 || strcmp(argv[i], "--manual") == 0) {
             mode = MODE_MANUAL;
@@ -92,37 +335,84 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (width < MIN_GRID_DIMENSION || width > MAX_GRID_DIMENSION ||
+        height < MIN_GRID_DIMENSION || height > MAX_GRID_DIMENSION) {
+        fprintf(stderr, "Board dimensions must be between %d and %d\n",
+                MIN_GRID_DIMENSION, MAX_GRID_DIMENSION);
+        return 1;
+    }
+
+    if (strategy->supports_board && !strategy->supports_board((int)width, (int)height)) {
+        fprintf(stderr, "The %s strategy cannot play a %lux%lu board\n", strategy->name, width, height);
+        return 1;
+    }
+
     /* Initialize memory tracker */
     memory_tracker_init();
 
+    /* Setup signal handling */
+    signal(SIGINT, signal_handler);
+
+    if (headless) {
+        /* Unbounded unless asked: deadlines make results depend on machine load */
+        SimulationConfig game = {(int)width, (int)height, strategy, path_algorithm,
+                                 (uint32_t)budget_ms, compare_paths};
+        return run_headless(&game, games, seed, (unsigned int)threads);
+    }
+
     /* Create game state */
-    GameState* state = game_state_create(mode);
+    GameState* state = game_state_create(mode, (int)width, (int)height, seed);
     if (!state) {
         fprintf(stderr, "Failed to create game state\n");
         return 1;
     }
 
+    /*
+     * AI mode: the controller (reused across restarts: the board size is
+     * fixed) runs on a worker thread, deciding on a snapshot of the state
+     * while the frame loop renders and sleeps.
+     */
+    AIWorker* ai_worker = NULL;
+    if (mode == MODE_AI_DEMO) {
+        AIController* ai_controller = ai_controller_create((int)width, (int)height, strategy);
+        if (ai_controller) {
+            ai_controller->path_algorithm = path_algorithm;
+
+            /* A decision slower than a frame holds the snake back: bound it by default */
+            unsigned long frame_budget_ms = budget_set ? budget_ms : MAX_AI_COMPUTE_MS;
+            ai_controller->time_budget_us = (uint64_t)frame_budget_ms * 1000ULL;
+        }
+
+        ai_worker = ai_worker_create(ai_controller, (int)width, (int)height);
+        if (!ai_worker) {
+            fprintf(stderr, "Failed to create AI controller\n");
+            game_state_destroy(state);
+            return 1;
+        }
+    }
+
     /* Create renderer */
-    Renderer* renderer = renderer_create();
+    Renderer* renderer = renderer_create((int)width, (int)height);
     if (!renderer) {
         fprintf(stderr, "Failed to create renderer\n");
+        ai_worker_destroy(ai_worker);
         game_state_destroy(state);
         return 1;
     }
 
-    /* Setup signal handling */
-    signal(SIGINT, signal_handler);
-
     /* Main game loop */
     Timer frame_timer;
     Direction last_input = DIR_NONE;
-    AIDecision* ai_decision = NULL;
+    const AIDecision* ai_decision = NULL;   /* Latest decision, drawn until the next one */
+    bool ai_pending = false;                /* A decision on the current state was requested */
+    Direction ai_applied = DIR_NONE;        /* Move applied since the last request */
 
     while (g_running) {
         timer_start(&frame_timer);
 
         /* Handle input */
         Direction input_dir = DIR_NONE;
+        bool ai_move_ready = false;
 
         if (mode == MODE_MANUAL) {
             input_dir = get_keyboard_input();
@@ -133,11 +423,22 @@ int main(int argc, char* argv[]) {
                 continue;
             }
         } else {
-            /* AI mode */
+            /* AI mode: collect the move computed during the previous frame */
             if (state->status == GAME_RUNNING) {
-                ai_decision = ai_make_decision(state);
-                if (ai_decision) {
-                    input_dir = ai_decision->chosen_direction;
+                if (!ai_pending) {
+                    ai_pending = ai_worker_request(ai_worker, state, ai_applied);
+                    if (ai_pending) {
+                        ai_applied = DIR_NONE;
+                    }
+                }
+
+                const AIDecision* decision = ai_pending ? ai_worker_poll(ai_worker) : NULL;
+                if (decision) {
+                    ai_decision = decision;
+                    ai_pending = false;
+                    ai_move_ready = true;
+                    input_dir = decision->chosen_direction;
+                    state->total_ai_time_us += decision->total_compute_time_us;
                 }
             }
 
@@ -147,10 +448,10 @@ int main(int argc, char* argv[]) {
                 g_running = 0;
             }
             if (ch == 'r' || ch == 'R') {
-                if (ai_decision) {
-                    ai_decision_destroy(ai_decision);
-                    ai_decision = NULL;
-                }
+                /* A decision still in flight is for the old game: abandon it */
+                ai_decision = NULL;
+                ai_pending = false;
+                ai_applied = DIR_NONE;
                 game_state_reset(state);
                 continue;
             }
@@ -167,7 +468,21 @@ int main(int argc, char* argv[]) {
                 last_input = input_dir;
             }
 
-            game_state_update(state, input_dir);
+            /* The AI snake waits for its decision (the worker is slower than a frame) */
+            if (mode == MODE_MANUAL || ai_move_ready) {
+                game_state_update(state, input_dir);
+            }
+
+            /* Start on the next move now: it is computed while this frame renders and sleeps */
+            if (ai_move_ready) {
+                ai_applied = state->snake->current_direction;
+                if (state->status == GAME_RUNNING) {
+                    ai_pending = ai_worker_request(ai_worker, state, ai_applied);
+                    if (ai_pending) {
+                        ai_applied = DIR_NONE;
+                    }
+                }
+            }
         }
 
         /* Render */
@@ -180,12 +495,6 @@ int main(int argc, char* argv[]) {
 
         renderer_refresh(renderer);
 
-        /* Cleanup AI decision */
-        if (ai_decision) {
-            ai_decision_destroy(ai_decision);
-            ai_decision = NULL;
-        }
-
         /* Frame rate limiting */
         timer_stop(&frame_timer);
         uint64_t elapsed_ms = timer_elapsed_ms(&frame_timer);
@@ -201,11 +510,13 @@ int main(int argc, char* argv[]) {
 
     /* Cleanup */
     renderer_destroy(renderer);
-    game_state_destroy(state);
+    ai_worker_destroy(ai_worker);
 
     printf("\nGame Over!\n");
-    printf("Final Score: %u\n", state ? state->snake->score : 0);
-    printf("Total Moves: %u\n", state ? state->moves_count : 0);
+    printf("Final Score: %u\n", state->snake->score);
+    printf("Total Moves: %u\n", state->moves_count);
+
+    game_state_destroy(state);
 
     return 0;
 }
@@ -5,11 +5,12 @@
 #include <string.h>
 
 /* Window dimensions */
-#define GAME_WIN_HEIGHT (GRID_HEIGHT + 2)  /* +2 for borders */
-#define GAME_WIN_WIDTH (GRID_WIDTH * 2 + 2)  /* *2 for spacing, +2 for borders */
+#define GAME_WIN_HEIGHT(grid_height) ((grid_height) + 2)  /* +2 for borders */
+#define GAME_WIN_WIDTH(grid_width) ((grid_width) * 2 + 2)  /* *2 for spacing, +2 for borders */
 #define STATS_WIN_WIDTH 40
+#define STATS_WIN_MIN_HEIGHT 35  /* Fullest panel: AI mode with every optional line */
 #define MIN_TERMINAL_HEIGHT 25
-#define MIN_TERMINAL_WIDTH (GAME_WIN_WIDTH + STATS_WIN_WIDTH + 1)
+#define MIN_TERMINAL_WIDTH(grid_width) (GAME_WIN_WIDTH(grid_width) + STATS_WIN_WIDTH + 1)
 
 static void renderer_init_colors(void) {
     start_color();
@@ -28,7 +29,7 @@ static void renderer_init_colors(void) {
     init_pair(COLOR_PAIR_UI_TEXT, COLOR_WHITE, -1);
 }
 
-Renderer* renderer_create(void) {
+Renderer* renderer_create(int grid_width, int grid_height) {
     /* Initialize ncurses */
     initscr();
     cbreak();
@@ -47,12 +48,24 @@ Renderer* renderer_create(void) {
     /* Get terminal size */
     getmaxyx(stdscr, renderer->terminal_height, renderer->terminal_width);
 
+    /* Window sizes follow the board size */
+    renderer->grid_width = grid_width;
+    renderer->grid_height = grid_height;
+    renderer->game_win_height = GAME_WIN_HEIGHT(grid_height);
+    renderer->game_win_width = GAME_WIN_WIDTH(grid_width);
+
+    int stats_win_height = renderer->game_win_height > STATS_WIN_MIN_HEIGHT ?
+                           renderer->game_win_height : STATS_WIN_MIN_HEIGHT;
+    int min_height = stats_win_height + 3 > MIN_TERMINAL_HEIGHT ?
+                     stats_win_height + 3 : MIN_TERMINAL_HEIGHT;
+    int min_width = MIN_TERMINAL_WIDTH(grid_width);
+
     /* Check minimum terminal size */
-    if (renderer->terminal_height < MIN_TERMINAL_HEIGHT ||
-        renderer->terminal_width < MIN_TERMINAL_WIDTH) {
+    if (renderer->terminal_height < min_height ||
+        renderer->terminal_width < min_width) {
         endwin();
-        fprintf(stderr, "Terminal too small! Need at least %dx%d\n",
-                MIN_TERMINAL_WIDTH, MIN_TERMINAL_HEIGHT);
+        fprintf(stderr, "Terminal too small! Need at least %dx%d for a %dx%d board\n",
+                min_width, min_height, grid_width, grid_height);
         memory_tracked_free(renderer);
         return NULL;
     }
@@ -61,8 +74,6 @@ Renderer* renderer_create(void) {
     renderer_init_colors();
 
     /* Create game window (left side) */
-    renderer->game_win_height = GAME_WIN_HEIGHT;
-    renderer->game_win_width = GAME_WIN_WIDTH;
     renderer->game_window = newwin(renderer->game_win_height,
                                    renderer->game_win_width,
                                    1, 1);
@@ -75,9 +86,9 @@ Renderer* renderer_create(void) {
 
     /* Create stats window (right side) */
     renderer->stats_win_width = STATS_WIN_WIDTH;
-    renderer->stats_window = newwin(renderer->game_win_height,
+    renderer->stats_window = newwin(stats_win_height,
                                     renderer->stats_win_width,
-                                    1, GAME_WIN_WIDTH + 2);
+                                    1, renderer->game_win_width + 2);
 
     if (!renderer->stats_window) {
         delwin(renderer->game_window);
@@ -132,8 +143,8 @@ void renderer_draw_game(Renderer* renderer, const GameState* state, const AIDeci
     ui_draw_border(win);
 
     /* Draw grid */
-    for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
+    for (int y = 0; y < state->grid.height; y++) {
+        for (int x = 0; x < state->grid.width; x++) {
             Position pos = {x, y};
             CellType cell = grid_get_cell(&state->grid, pos);
             char ch = renderer_get_cell_char(cell);
@@ -221,19 +232,24 @@ void renderer_draw_stats(Renderer* renderer, const GameState* state, const AIDec
             ui_draw_stat_line(win, line++, "Access Space", space_buf);
 
             /* Space as percentage of grid */
-            size_t grid_size = GRID_WIDTH * GRID_HEIGHT;
+            size_t grid_size = grid_cell_count(&state->grid);
             float space_percent = (float)ai_decision->space_analysis->accessible_cells / grid_size * 100.0f;
             char space_pct_buf[32];
             snprintf(space_pct_buf, sizeof(space_pct_buf), "%.1f%%", space_percent);
             ui_draw_stat_line(win, line++, "Space %", space_pct_buf);
         }
 
-        /* BFS compute time */
+        /* Path search compute time and effort */
         if (ai_decision->path_to_food) {
-            char bfs_time_buf[32];
-            snprintf(bfs_time_buf, sizeof(bfs_time_buf), "%.2f ms",
+            char path_time_buf[32];
+            snprintf(path_time_buf, sizeof(path_time_buf), "%.2f ms",
                      ai_decision->path_to_food->compute_time_us / 1000.0);
-            ui_draw_stat_line(win, line++, "BFS Time", bfs_time_buf);
+            ui_draw_stat_line(win, line++, "Path Time", path_time_buf);
+
+            char path_nodes_buf[32];
+            snprintf(path_nodes_buf, sizeof(path_nodes_buf), "%zu",
+                     ai_decision->path_to_food->nodes_expanded);
+            ui_draw_stat_line(win, line++, "Path Nodes", path_nodes_buf);
         }
 
         /* Safety check status */
@@ -265,14 +281,25 @@ void renderer_draw_stats(Renderer* renderer, const GameState* state, const AIDec
             ui_draw_stat_line(win, line++, "Safety", "N/A");
         }
 
+        /* Full-path safety of the path to food */
+        if (ai_decision->path_safety) {
+            ui_draw_stat_line(win, line++, "Food Path",
+                              ai_decision->path_safety->is_safe ? "SAFE" : "TRAP");
+        }
+
         /* Total AI compute time */
         char total_time_buf[32];
-        snprintf(total_time_buf, sizeof(total_time_buf), "%.2f ms",
-                 ai_decision->total_compute_time_us / 1000.0);
+        snprintf(total_time_buf, sizeof(total_time_buf), "%.2f ms%s",
+                 ai_decision->total_compute_time_us / 1000.0,
+                 ai_decision->hit_deadline ? " (cut)" : "");
         ui_draw_stat_line(win, line++, "Total Time", total_time_buf);
 
         /* Strategy indicators */
-        if (ai_decision->used_space_strategy && !ai_decision->used_fallback) {
+        if (ai_decision->used_hamiltonian) {
+            wattron(win, COLOR_PAIR(COLOR_PAIR_SNAKE_BODY) | A_BOLD);
+            mvwprintw(win, line++, 2, "  [Hamiltonian Cycle]");
+            wattroff(win, COLOR_PAIR(COLOR_PAIR_SNAKE_BODY) | A_BOLD);
+        } else if (ai_decision->used_space_strategy && !ai_decision->used_fallback) {
             wattron(win, COLOR_PAIR(COLOR_PAIR_SNAKE_BODY) | A_BOLD);
             mvwprintw(win, line++, 2, "  [Space Strategy]");
             wattroff(win, COLOR_PAIR(COLOR_PAIR_SNAKE_BODY) | A_BOLD);
@@ -327,8 +354,8 @@ void renderer_draw_game_over(Renderer* renderer, const GameState* state) {
 
     int msg1_len = (int)strlen(msg1);
     int msg2_len = (int)strlen(msg2);
-    int center_y = GRID_HEIGHT / 2;
-    int center_x = GAME_WIN_WIDTH / 2;
+    int center_y = renderer->grid_height / 2;
+    int center_x = renderer->game_win_width / 2;
 
     wattron(win, A_BOLD | A_BLINK);
     mvwprintw(win, center_y, center_x - msg1_len / 2, "%s", msg1);
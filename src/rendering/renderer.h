@@ -14,6 +14,8 @@ typedef struct {
     WINDOW* stats_window;
     int terminal_height;
     int terminal_width;
+    int grid_width;
+    int grid_height;
     int game_win_height;
     int game_win_width;
     int stats_win_width;
@@ -21,9 +23,11 @@ typedef struct {
 
 /**
  * Create and initialize renderer
- * @return Pointer to new renderer or NULL on failure
+ * @param grid_width Board width in cells
+ * @param grid_height Board height in cells
+ * @return Pointer to new renderer or NULL on failure (e.g. terminal too small)
  */
-Renderer* renderer_create(void);
+Renderer* renderer_create(int grid_width, int grid_height);
 
 /**
  * Destroy renderer and cleanup ncurses
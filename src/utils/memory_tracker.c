@@ -1,14 +1,46 @@
+#define _POSIX_C_SOURCE 200112L
 #include "memory_tracker.h"
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+/*
+ * Global memory tracking state
+ *
+ * Allocations are first counted in a per-thread slot that only its owner
+ * writes, so tracked malloc/free never contend on a shared cache line. A slot
+ * is flushed into the global counters once its net balance reaches
+ * MEMORY_FLUSH_BYTES (either sign) and when its thread exits. Readers add the
+ * unflushed balance of every live slot to the global count.
+ *
+ * Peak usage is raised on every allocation from the global count plus the
+ * allocating thread's own balance, so it is exact for a single thread and
+ * low by at most MEMORY_FLUSH_BYTES per other thread otherwise.
+ */
+#define MEMORY_FLUSH_BYTES 4096
+#define MEMORY_MAX_THREAD_SLOTS 256
+
+typedef struct {
+    _Alignas(64) _Atomic int64_t pending;   /* Net bytes not yet flushed (owner writes only) */
+    atomic_bool in_use;
+} ThreadSlot;
 
-/* Global memory tracking state */
 static struct {
-    uint64_t current_bytes;
-    uint64_t peak_bytes;
-    bool initialized;
-} g_memory_tracker = {0, 0, false};
+    _Atomic int64_t current_bytes;          /* Flushed net bytes */
+    _Atomic int64_t peak_bytes;
+    atomic_bool initialized;
+    _Atomic unsigned int slot_limit;        /* Slots ever claimed: bound for reader scans */
+    ThreadSlot slots[MEMORY_MAX_THREAD_SLOTS];
+} g_memory_tracker;
+
+static pthread_key_t g_slot_key;
+static pthread_once_t g_slot_key_once = PTHREAD_ONCE_INIT;
+
+/* Slot of the calling thread; NULL until claimed or if all slots are taken */
+static _Thread_local ThreadSlot* t_slot;
+static _Thread_local bool t_slot_claimed;
 
 /* Header prepended to each allocation to track size */
 typedef struct {
@@ -18,14 +50,129 @@ typedef struct {
 
 #define ALLOCATION_MAGIC 0xDEADBEEF
 
+/* Arena block: header followed by `capacity` usable bytes */
+struct MemoryArenaBlock {
+    MemoryArenaBlock* next;     /* Older block */
+    size_t capacity;
+    size_t used;
+    unsigned char data[];
+};
+
+#define ARENA_ALIGNMENT _Alignof(max_align_t)
+
+/* Raise peak to at least `current` without losing a concurrent larger peak */
+static void memory_update_peak(int64_t current) {
+    int64_t peak = atomic_load_explicit(&g_memory_tracker.peak_bytes, memory_order_relaxed);
+    while (current > peak &&
+           !atomic_compare_exchange_weak(&g_memory_tracker.peak_bytes, &peak, current)) {
+        /* peak reloaded by the failed exchange */
+    }
+}
+
+/* Move a thread's balance into the global counters */
+static void memory_flush(int64_t delta) {
+    int64_t current = atomic_fetch_add(&g_memory_tracker.current_bytes, delta) + delta;
+    if (delta > 0) {
+        memory_update_peak(current);
+    }
+}
+
+/* Thread exit: hand the remaining balance to the global count and free the slot */
+static void memory_slot_release(void* arg) {
+    ThreadSlot* slot = (ThreadSlot*)arg;
+    int64_t pending = atomic_exchange(&slot->pending, 0);
+    memory_flush(pending);
+    atomic_store(&slot->in_use, false);
+}
+
+static void memory_slot_key_create(void) {
+    pthread_key_create(&g_slot_key, memory_slot_release);
+}
+
+/* Claim a free slot for the calling thread (once per thread) */
+static ThreadSlot* memory_thread_slot(void) {
+    if (t_slot_claimed) {
+        return t_slot;
+    }
+    t_slot_claimed = true;
+
+    pthread_once(&g_slot_key_once, memory_slot_key_create);
+
+    for (unsigned int i = 0; i < MEMORY_MAX_THREAD_SLOTS; i++) {
+        ThreadSlot* slot = &g_memory_tracker.slots[i];
+        bool expected = false;
+        if (!atomic_compare_exchange_strong(&slot->in_use, &expected, true)) {
+            continue;
+        }
+
+        unsigned int limit = atomic_load(&g_memory_tracker.slot_limit);
+        while (limit < i + 1 &&
+               !atomic_compare_exchange_weak(&g_memory_tracker.slot_limit, &limit, i + 1)) {
+            /* limit reloaded by the failed exchange */
+        }
+
+        pthread_setspecific(g_slot_key, slot);
+        t_slot = slot;
+        return slot;
+    }
+
+    /* Out of slots: this thread updates the global counters directly */
+    return NULL;
+}
+
+/* Count `delta` bytes against the calling thread */
+static void memory_account(int64_t delta) {
+    ThreadSlot* slot = memory_thread_slot();
+    if (!slot) {
+        memory_flush(delta);
+        return;
+    }
+
+    int64_t pending = atomic_load_explicit(&slot->pending, memory_order_relaxed) + delta;
+
+    if (pending >= MEMORY_FLUSH_BYTES || pending <= -MEMORY_FLUSH_BYTES) {
+        atomic_store_explicit(&slot->pending, 0, memory_order_relaxed);
+        memory_flush(pending);
+        return;
+    }
+
+    atomic_store_explicit(&slot->pending, pending, memory_order_relaxed);
+
+    if (delta > 0) {
+        /* Shared lines are only read here; peak is written when it actually rises */
+        int64_t estimate = atomic_load_explicit(&g_memory_tracker.current_bytes,
+                                                memory_order_relaxed) + pending;
+        if (estimate > atomic_load_explicit(&g_memory_tracker.peak_bytes, memory_order_relaxed)) {
+            memory_update_peak(estimate);
+        }
+    }
+}
+
+/* Flushed count plus every live thread's unflushed balance */
+static int64_t memory_aggregate_current(void) {
+    int64_t total = atomic_load(&g_memory_tracker.current_bytes);
+    unsigned int limit = atomic_load(&g_memory_tracker.slot_limit);
+
+    for (unsigned int i = 0; i < limit; i++) {
+        total += atomic_load_explicit(&g_memory_tracker.slots[i].pending, memory_order_relaxed);
+    }
+
+    return total > 0 ? total : 0;
+}
+
 void memory_tracker_init(void) {
-    g_memory_tracker.current_bytes = 0;
-    g_memory_tracker.peak_bytes = 0;
-    g_memory_tracker.initialized = true;
+    ThreadSlot* slot = memory_thread_slot();
+    if (slot) {
+        atomic_store(&slot->pending, 0);
+    }
+
+    atomic_store(&g_memory_tracker.current_bytes, 0);
+    atomic_store(&g_memory_tracker.peak_bytes, 0);
+    atomic_store(&g_memory_tracker.initialized, true);
 }
 
 void* memory_tracked_malloc(size_t size) {
-    if (!g_memory_tracker.initialized) {
+    if (!atomic_load_explicit(&g_memory_tracker.initialized, memory_order_relaxed)) {
         memory_tracker_init();
     }
 
@@ -46,10 +193,7 @@ void* memory_tracked_malloc(size_t size) {
     header->magic = ALLOCATION_MAGIC;
 
     /* Update statistics */
-    g_memory_tracker.current_bytes += size;
-    if (g_memory_tracker.current_bytes > g_memory_tracker.peak_bytes) {
-        g_memory_tracker.peak_bytes = g_memory_tracker.current_bytes;
-    }
+    memory_account((int64_t)size);
 
     /* Return pointer after header */
     return (void*)(header + 1);
@@ -81,20 +225,110 @@ void memory_tracked_free(void* ptr) {
     }
 
     /* Update statistics */
-    g_memory_tracker.current_bytes -= header->size;
+    memory_account(-(int64_t)header->size);
 
     /* Free the whole allocation (including header) */
     free(header);
 }
 
 uint64_t memory_get_current_usage(void) {
-    return g_memory_tracker.current_bytes;
+    return (uint64_t)memory_aggregate_current();
 }
 
 uint64_t memory_get_peak_usage(void) {
-    return g_memory_tracker.peak_bytes;
+    int64_t peak = atomic_load(&g_memory_tracker.peak_bytes);
+    int64_t current = memory_aggregate_current();
+    return (uint64_t)(current > peak ? current : peak);
 }
 
 void memory_tracker_reset(void) {
-    g_memory_tracker.peak_bytes = g_memory_tracker.current_bytes;
+    atomic_store(&g_memory_tracker.peak_bytes, memory_aggregate_current());
+}
+
+static MemoryArenaBlock* memory_arena_block_create(size_t capacity) {
+    MemoryArenaBlock* block = (MemoryArenaBlock*)memory_tracked_malloc(
+        sizeof(MemoryArenaBlock) + capacity);
+    if (!block) {
+        return NULL;
+    }
+
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+    return block;
+}
+
+bool memory_arena_init(MemoryArena* arena, size_t block_size) {
+    if (!arena || block_size == 0) {
+        return false;
+    }
+
+    arena->block_size = block_size;
+    arena->head = memory_arena_block_create(block_size);
+    return arena->head != NULL;
+}
+
+void memory_arena_destroy(MemoryArena* arena) {
+    if (!arena) {
+        return;
+    }
+
+    MemoryArenaBlock* block = arena->head;
+    while (block) {
+        MemoryArenaBlock* next = block->next;
+        memory_tracked_free(block);
+        block = next;
+    }
+    arena->head = NULL;
+}
+
+/* Offset of the next aligned allocation in a block */
+static size_t memory_arena_aligned_offset(const MemoryArenaBlock* block) {
+    uintptr_t address = (uintptr_t)(block->data + block->used);
+    uintptr_t aligned = (address + ARENA_ALIGNMENT - 1) & ~(uintptr_t)(ARENA_ALIGNMENT - 1);
+    return block->used + (size_t)(aligned - address);
+}
+
+void* memory_arena_alloc(MemoryArena* arena, size_t size) {
+    if (!arena || !arena->head || size == 0) {
+        return NULL;
+    }
+
+    MemoryArenaBlock* block = arena->head;
+    size_t offset = memory_arena_aligned_offset(block);
+
+    if (offset > block->capacity || size > block->capacity - offset) {
+        /* Chain in a new block big enough for this request */
+        size_t capacity = arena->block_size;
+        if (capacity < size + ARENA_ALIGNMENT) {
+            capacity = size + ARENA_ALIGNMENT;
+        }
+
+        block = memory_arena_block_create(capacity);
+        if (!block) {
+            return NULL;
+        }
+
+        block->next = arena->head;
+        arena->head = block;
+        offset = memory_arena_aligned_offset(block);
+    }
+
+    block->used = offset + size;
+    return block->data + offset;
+}
+
+void memory_arena_reset(MemoryArena* arena) {
+    if (!arena || !arena->head) {
+        return;
+    }
+
+    /* Free overflow blocks, keep the first (oldest) one */
+    while (arena->head->next) {
+        MemoryArenaBlock* block = arena->head;
+        arena->head = block->next;
+        memory_tracked_free(block);
+    }
+
+    arena->head->used = 0;
 }
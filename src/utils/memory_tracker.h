@@ -3,15 +3,19 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 /**
  * Memory tracking system for monitoring heap allocations
  * Wraps malloc/calloc/free to track current and peak memory usage
+ * Safe to call from multiple threads: each thread counts into its own slot,
+ * which is flushed to the shared totals in batches, and readers aggregate
+ * all slots
  */
 
 /**
  * Initialize the memory tracker
- * Must be called before any tracked allocations
+ * Must be called before any tracked allocations, and before starting threads
  */
 void memory_tracker_init(void);
 
@@ -54,4 +58,49 @@ uint64_t memory_get_peak_usage(void);
  */
 void memory_tracker_reset(void);
 
+/**
+ * Bump allocator for short-lived objects that all die together
+ *
+ * Allocation advances a pointer inside a tracked block; there is no per-object
+ * free. memory_arena_reset releases everything at once, keeping the first
+ * block for reuse. When a block fills up another one is chained in, so
+ * allocation only fails if the heap does. Blocks come from
+ * memory_tracked_malloc and so count toward current and peak usage.
+ * An arena must not be shared between threads.
+ */
+typedef struct MemoryArenaBlock MemoryArenaBlock;
+
+typedef struct {
+    MemoryArenaBlock* head;     /* Block currently allocated from (newest first) */
+    size_t block_size;          /* Usable size of the first and of new blocks */
+} MemoryArena;
+
+/**
+ * Initialize an arena and allocate its first block
+ * @param arena Arena to initialize
+ * @param block_size Usable bytes per block
+ * @return true on success, false if the first block could not be allocated
+ */
+bool memory_arena_init(MemoryArena* arena, size_t block_size);
+
+/**
+ * Free all blocks of an arena
+ * @param arena Arena to destroy (the MemoryArena struct itself is not freed)
+ */
+void memory_arena_destroy(MemoryArena* arena);
+
+/**
+ * Allocate from an arena (aligned for any object type)
+ * @param arena Arena to allocate from
+ * @param size Number of bytes
+ * @return Pointer valid until the next memory_arena_reset, or NULL on failure
+ */
+void* memory_arena_alloc(MemoryArena* arena, size_t size);
+
+/**
+ * Release every allocation made since the last reset
+ * @param arena Arena to reset
+ */
+void memory_arena_reset(MemoryArena* arena);
+
 #endif /* MEMORY_TRACKER_H */
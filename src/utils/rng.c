@@ -0,0 +1,51 @@
+#include "rng.h"
+
+#define PCG32_MULTIPLIER 6364136223846793005ULL
+#define PCG32_DEFAULT_STREAM 1442695040888963407ULL
+
+void rng_seed(Rng* rng, uint64_t seed) {
+    if (!rng) {
+        return;
+    }
+
+    /* Standard PCG32 seeding sequence */
+    rng->state = 0;
+    rng->inc = PCG32_DEFAULT_STREAM | 1ULL;
+    rng_next_u32(rng);
+    rng->state += seed;
+    rng_next_u32(rng);
+}
+
+uint32_t rng_next_u32(Rng* rng) {
+    uint64_t old_state = rng->state;
+    rng->state = old_state * PCG32_MULTIPLIER + rng->inc;
+
+    /* XSH-RR output permutation */
+    uint32_t xorshifted = (uint32_t)(((old_state >> 18) ^ old_state) >> 27);
+    uint32_t rotation = (uint32_t)(old_state >> 59);
+    return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+}
+
+uint32_t rng_bounded(Rng* rng, uint32_t bound) {
+    if (bound == 0) {
+        return 0;
+    }
+
+    /*
+     * Lemire's multiply-shift: the high 32 bits of value * bound are uniform
+     * in [0, bound) once the few values in the biased low zone are rejected.
+     * The division is only computed when a value falls in that zone.
+     */
+    uint64_t product = (uint64_t)rng_next_u32(rng) * bound;
+    uint32_t low = (uint32_t)product;
+
+    if (low < bound) {
+        uint32_t threshold = (uint32_t)(-bound) % bound;
+        while (low < threshold) {
+            product = (uint64_t)rng_next_u32(rng) * bound;
+            low = (uint32_t)product;
+        }
+    }
+
+    return (uint32_t)(product >> 32);
+}
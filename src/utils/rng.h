@@ -0,0 +1,53 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/**
+ * PCG32 pseudo-random number generator
+ * Small, fast and fully deterministic: each game owns one, so results can be
+ * reproduced from the seed and games can run on separate threads.
+ */
+typedef struct {
+    uint64_t state;
+    uint64_t inc;    /* Stream selector, always odd */
+} Rng;
+
+/**
+ * Seed a generator
+ * @param rng Generator to seed
+ * @param seed Seed value (same seed gives the same sequence)
+ */
+void rng_seed(Rng* rng, uint64_t seed);
+
+/**
+ * Get the next 32-bit random value
+ * @param rng Generator to advance
+ * @return Uniformly distributed 32-bit value
+ */
+uint32_t rng_next_u32(Rng* rng);
+
+/**
+ * Get an unbiased random value in [0, bound)
+ * Uses multiply-shift with rejection instead of modulo
+ * @param rng Generator to advance
+ * @param bound Exclusive upper bound (must be > 0)
+ * @return Uniformly distributed value below bound
+ */
+uint32_t rng_bounded(Rng* rng, uint32_t bound);
+
+/**
+ * SplitMix64 finalizer: a stateless bijective mix of a 64-bit value
+ * Distinct inputs give well-distributed, independent-looking outputs, so it
+ * can derive per-item random keys from item indices without storing a table.
+ * @param value Value to mix
+ * @return Mixed value
+ */
+static inline uint64_t rng_splitmix64(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+#endif /* RNG_H */
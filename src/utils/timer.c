@@ -30,3 +30,9 @@ uint64_t timer_elapsed_us(const Timer* timer) {
 uint64_t timer_elapsed_ms(const Timer* timer) {
     return timer_elapsed_us(timer) / 1000ULL;
 }
+
+uint64_t timer_now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000ULL + (uint64_t)now.tv_nsec / 1000ULL;
+}
@@ -39,4 +39,11 @@ uint64_t timer_elapsed_us(const Timer* timer);
  */
 uint64_t timer_elapsed_ms(const Timer* timer);
 
+/**
+ * Get the current monotonic time
+ * Comparable only with other timer_now_us values (e.g. for deadlines)
+ * @return Time in microseconds since an arbitrary fixed point
+ */
+uint64_t timer_now_us(void);
+
 #endif /* TIMER_H */